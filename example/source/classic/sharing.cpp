@@ -169,7 +169,7 @@ int main()
         // int left, right;
         // glfwGetWindowFrameSize(windows[0].handle(), &left, NULL, &right, NULL);
 
-        auto& [title, pos, dim, frame, cursor, mouse, keys, mon] = windows[0].properties();
+        auto& [title, pos, dim, frame, scale, cursor, mouse, keys, mon] = windows[0].properties();
         windows[1].set_window_pos(pos.x + dim.width, pos.y);
     }
 
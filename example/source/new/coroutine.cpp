@@ -0,0 +1,118 @@
+#include <glbinding/gl/gl.h>
+#include <glbinding/glbinding.h>
+
+#include <glfw_cpp/coroutine.hpp>
+#include <glfw_cpp/glfw_cpp.hpp>
+
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <thread>
+
+using namespace gl;    // from <glbinding/gl/gl.h>
+
+namespace co = glfw_cpp::co;
+namespace ev = glfw_cpp::event;
+
+// shared by the flows, they all run on the render thread so no synchronization is needed
+struct Scene
+{
+    float elapsed = 0.0F;
+    float flash   = 0.0F;
+};
+
+// clears the screen every frame with a slowly cycling color, brightened by the flash
+co::Task background(glfw_cpp::Window& window, Scene& scene)
+{
+    while (not window.should_close()) {
+        const auto& events = co_await window.next_frame();
+
+        if (auto resized = events.last<ev::FramebufferResized>()) {
+            glViewport(0, 0, resized->width, resized->height);
+        }
+
+        scene.elapsed += static_cast<float>(window.delta_time());
+
+        const auto r = (std::sin(23.0F / 8.0F * scene.elapsed) + 1.0F) * 0.1F + 0.4F + scene.flash;
+        const auto g = (std::cos(13.0F / 8.0F * scene.elapsed) + 1.0F) * 0.2F + 0.3F + scene.flash;
+        const auto b = (std::sin(41.0F / 8.0F * scene.elapsed) + 1.5F) * 0.2F + scene.flash;
+
+        glClearColor(r, g, b, 1.0F);
+        glClear(GL_COLOR_BUFFER_BIT);
+    }
+}
+
+// waits for a click, then fades a flash out over two seconds; no state machine needed
+co::Task flash_on_click(glfw_cpp::Instance& glfw, glfw_cpp::Window& window, Scene& scene)
+{
+    while (not window.should_close()) {
+        auto click = co_await window.next<ev::ButtonPressed>();
+        if (click.state != glfw_cpp::MouseButtonState::Press) {
+            continue;
+        }
+
+        // monitor queries must be done on the main thread
+        auto monitor = co_await glfw.on_main_thread([] {
+            return std::string{ glfw_cpp::get_primary_monitor().name() };
+        });
+        std::printf("click! (primary monitor: %s)\n", monitor.c_str());
+
+        for (auto time = 0.0F; time < 2.0F; time += static_cast<float>(window.delta_time())) {
+            scene.flash = 0.5F * (1.0F - time / 2.0F);
+            co_await window.next_frame();
+        }
+        scene.flash = 0.0F;
+    }
+}
+
+co::Task quit_on_q(glfw_cpp::Window& window)
+{
+    while (true) {
+        auto key = co_await window.next<ev::KeyPressed>();
+        if (key.key == glfw_cpp::KeyCode::Q) {
+            window.request_close();
+            co_return;
+        }
+    }
+}
+
+void window_thread(glfw_cpp::Instance& glfw, glfw_cpp::Window&& window)
+{
+    glfw_cpp::make_current(window.handle());
+    glbinding::initialize(glfw_cpp::get_proc_address);
+
+    auto scene  = Scene{};
+    auto runner = co::Runner{ window };
+
+    runner.spawn(background(window, scene));
+    runner.spawn(flash_on_click(glfw, window, scene));
+    runner.spawn(quit_on_q(window));
+
+    // all three flows share this thread; the loop ends once the window is requested to close
+    runner.run();
+}
+
+int main()
+{
+    auto glfw = glfw_cpp::init({});
+
+    glfw->set_error_callback([](glfw_cpp::ErrorCode code, std::string_view msg) {
+        fprintf(stderr, "glfw-cpp [%20s]: %s\n", to_string(code).data(), msg.data());
+    });
+
+    glfw->apply_hints({
+        .api = glfw_cpp::api::OpenGL{
+            .version_major = 3,
+            .version_minor = 3,
+            .profile       = glfw_cpp::gl::Profile::Core,
+        },
+    });
+
+    auto window = glfw->create_window(800, 600, "Hello coroutines (click, Q to quit)");
+    auto thread = std::jthread{ window_thread, std::ref(*glfw), std::move(window) };
+
+    while (glfw->has_window_opened()) {
+        using glfw_cpp::operator""_fps;
+        glfw->poll_events(120_fps);
+    }
+}
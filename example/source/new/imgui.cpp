@@ -15,26 +15,26 @@ auto render_thread(glfw_cpp::Window& window)
     ImGui::CreateContext();
     ImGui::StyleColorsDark();
 
-    // NOTE: imgui should not install callback because there is no synchronization between the event
-    //       pushing on `glfwPollEvents` thread and general imgui usage in this thread. This function
-    //       basically a wrapper of `ImGui_ImplGlfw_InitForOpenGL()` with the second parameter set to false.
-    glfw_cpp::imgui::init_for_opengl(window.handle());
+    // NOTE: the direct bridge feeds `ImGuiIO` from the event queue of the window without any GLFW call, so
+    //       it's safe to use on this thread. Alternatively `glfw_cpp::imgui::init_for_opengl()` wraps
+    //       `ImGui_ImplGlfw_InitForOpenGL()` without installing callbacks, but the `ImGui_ImplGlfw` functions
+    //       query GLFW which should be done on the main thread.
+    glfw_cpp::imgui::direct::init(ImGui::GetIO());
     ImGui_ImplOpenGL3_Init();
 
     glClearColor(0.1f, 0.1f, 0.11f, 1.0f);
 
-    while (not window.should_close()) {
+    // NOTE: only render when something happened: the function is called again right away while it returns
+    //       true, otherwise `run_on_demand()` blocks until the next event or `window.invalidate()`.
+    window.run_on_demand([&](const glfw_cpp::EventQueue& events) {
         namespace ev = glfw_cpp::event;
 
-        // swap events queued by `glfw_cpp::poll_events()` or `glfw_cpp::wait_events()`
-        const auto& events = window.swap_events();
-
         // process events manually.
-        glfw_cpp::imgui::process_events(window.handle(), events);
+        glfw_cpp::imgui::direct::process_events(ImGui::GetIO(), events);
 
         // // or you can use the single event one
         // for (const auto& event : events) {
-        //     glfw_cpp::imgui::process_event(window.handle(), event);
+        //     glfw_cpp::imgui::direct::process_event(ImGui::GetIO(), event);
         // }
 
         events.visit(ev::Overload{
@@ -51,7 +51,7 @@ auto render_thread(glfw_cpp::Window& window)
         glClear(GL_COLOR_BUFFER_BIT);
 
         ImGui_ImplOpenGL3_NewFrame();
-        glfw_cpp::imgui::new_frame();    // basically `ImGui_ImplGlfw_NewFrame()`
+        glfw_cpp::imgui::direct::new_frame(ImGui::GetIO(), window);
         ImGui::NewFrame();
 
         ImGui::ShowDemoWindow();
@@ -59,11 +59,11 @@ auto render_thread(glfw_cpp::Window& window)
         ImGui::Render();
         ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
 
-        window.swap_buffers();
-    }
+        return glfw_cpp::imgui::wants_redraw(events);
+    });
 
     ImGui_ImplOpenGL3_Shutdown();
-    glfw_cpp::imgui::shutdown();    // same as `ImGui_ImplGlfw_Shutdown()`
+    glfw_cpp::imgui::direct::shutdown(ImGui::GetIO());
 }
 
 int main()
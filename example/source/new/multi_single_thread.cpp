@@ -2,10 +2,12 @@
 #include <glbinding/glbinding.h>
 
 #include <glfw_cpp/glfw_cpp.hpp>
+#include <glfw_cpp/swap_coordinator.hpp>
 
 #include <array>
 #include <chrono>
 #include <cmath>
+#include <optional>
 #include <ranges>
 
 using namespace gl;    // from <glbinding/gl/gl.h>
@@ -38,50 +40,55 @@ int main()
     // default constructed windows will have nullptr as its handle
     auto windows = std::array<glfw_cpp::Window, 3>{};
 
+    // only one swap per frame waits for vsync, so every window presents at the display rate
+    auto coordinator = glfw_cpp::SwapCoordinator{};
+
     for (auto i : std::views::iota(0u, windows.size())) {
         windows[i] = glfw->create_window(800, 600, std::format("Hello glfw-cpp {}", i));
 
         glfw_cpp::make_current(windows[i].handle());
         glbinding::initialize(i, glfw_cpp::get_proc_address);    // initialize current context with handle i
 
-        windows[i].set_vsync(false);
+        // the last window is rendered at half the rate of the others
+        auto rate = i + 1 == windows.size() ? std::optional{ 30.0 } : std::nullopt;
+        coordinator.add(windows[i], rate);
     }
 
-    while (glfw->has_window_opened()) {
-        for (auto i : std::views::iota(0u, windows.size())) {
-            auto& win = windows[i];
+    auto render = [&](glfw_cpp::Window& win, const glfw_cpp::EventQueue& events) {
+        // see https://glbinding.org/ for more detail
+        glbinding::useCurrentContext();    // use current active context
 
-            auto delta = win.use([&](const glfw_cpp::EventQueue& events) {
-                // see https://glbinding.org/ for more detail
-                glbinding::useCurrentContext();    // use current active context
-                // glbinding::useContext(i);       // or use the handle registerned beforehand
+        events.visit(glfw_cpp::event::Overload{
+            [&](const glfw_cpp::event::KeyPressed& e) {
+                e.key == glfw_cpp::KeyCode::Q ? win.request_close() : void();
+            },
+            [&](const auto&) { /* do nothing */ },
 
-                events.visit(glfw_cpp::event::Overload{
-                    [&](const glfw_cpp::event::KeyPressed& e) {
-                        e.key == glfw_cpp::KeyCode::Q ? win.request_close() : void();
-                    },
-                    [&](const auto&) { /* do nothing */ },
+        });
 
-                });
+        auto epoch = std::chrono::steady_clock::now().time_since_epoch();
+        auto time  = std::chrono::duration_cast<std::chrono::duration<float>>(epoch).count();
 
-                auto epoch = std::chrono::steady_clock::now().time_since_epoch();
-                auto time  = std::chrono::duration_cast<std::chrono::duration<float>>(epoch).count();
+        // funny color cycle
+        const float r = (std::sin(23.0F / 8.0F * time) + 1.0F) * 0.1F + 0.4F;
+        const float g = (std::cos(13.0F / 8.0F * time) + 1.0F) * 0.2F + 0.3F;
+        const float b = (std::sin(41.0F / 8.0F * time) + 1.5F) * 0.2F;
 
-                // funny color cycle
-                const float r = (std::sin(23.0F / 8.0F * time) + 1.0F) * 0.1F + 0.4F;
-                const float g = (std::cos(13.0F / 8.0F * time) + 1.0F) * 0.2F + 0.3F;
-                const float b = (std::sin(41.0F / 8.0F * time) + 1.5F) * 0.2F;
+        glClearColor(r, g, b, 1.0F);
+        glClear(GL_COLOR_BUFFER_BIT);
+    };
 
-                glClearColor(r, g, b, 1.0F);
-                glClear(GL_COLOR_BUFFER_BIT);
-            });
+    while (glfw->has_window_opened()) {
+        if (coordinator.frame(render) == 0) {
+            break;
+        }
 
-            if (!delta.has_value()) {
+        for (auto& win : windows) {
+            if (win.should_close() and win.attributes().visible) {
                 win.hide();
             }
         }
 
-        using glfw_cpp::operator""_fps;
-        glfw->poll_events(120_fps);
+        glfw->poll_events();
     }
 }
@@ -0,0 +1,232 @@
+// Compares `glfw_cpp::RenderScheduler` against one thread per window on the Null platform (headless, the
+// contexts are created with OSMesa so no display is needed).
+//
+// usage: scheduler_bench [windows=32] [threads=hardware_concurrency] [rate=60] [seconds=5]
+
+#include <glfw_cpp/glfw_cpp.hpp>
+#include <glfw_cpp/render_scheduler.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <format>
+#include <functional>
+#include <ranges>
+#include <thread>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+#if defined(_WIN32)
+    #define GL_APIENTRY __stdcall
+#else
+    #define GL_APIENTRY
+#endif
+
+using ClearColorFn = void(GL_APIENTRY*)(float, float, float, float);
+using ClearFn      = void(GL_APIENTRY*)(unsigned int);
+
+constexpr unsigned int GL_COLOR_BUFFER_BIT = 0x00004000;
+
+struct Config
+{
+    std::size_t windows = 32;
+    std::size_t threads = std::thread::hardware_concurrency();
+    double      rate    = 60.0;
+    double      seconds = 5.0;
+};
+
+struct Result
+{
+    std::size_t frames = 0;
+    std::size_t missed = 0;
+    double      time   = 0.0;
+};
+
+struct Gl
+{
+    ClearColorFn clear_color = nullptr;
+    ClearFn      clear       = nullptr;
+};
+
+// resolving proc addresses needs a current context, it's released afterwards for the render threads
+Gl load_gl(glfw_cpp::Window& window)
+{
+    glfw_cpp::make_current(window.handle());
+    auto gl = Gl{
+        .clear_color = reinterpret_cast<ClearColorFn>(glfw_cpp::get_proc_address("glClearColor")),
+        .clear       = reinterpret_cast<ClearFn>(glfw_cpp::get_proc_address("glClear")),
+    };
+    glfw_cpp::make_current(nullptr);
+    return gl;
+}
+
+// a frame that does a little bit of work so the contexts are actually used
+void draw(glfw_cpp::Window& window, const Gl& gl)
+{
+    auto t = static_cast<float>(window.delta_time());
+    gl.clear_color(t, 0.2F, 0.3F, 1.0F);
+    gl.clear(GL_COLOR_BUFFER_BIT);
+}
+
+void pump_events(glfw_cpp::Instance& glfw, double seconds)
+{
+    auto end = Clock::now() + std::chrono::duration<double>{ seconds };
+    while (Clock::now() < end) {
+        using glfw_cpp::operator""_fps;
+        glfw.poll_events(120_fps);
+    }
+}
+
+Result run_scheduler(glfw_cpp::Instance& glfw, std::vector<glfw_cpp::Window>& windows, const Config& config)
+{
+    auto gl = load_gl(windows.front());
+
+    auto start     = Clock::now();
+    auto scheduler = glfw_cpp::RenderScheduler{ config.threads };
+
+    for (auto& window : windows) {
+        scheduler.add(
+            window,
+            [&](glfw_cpp::Window& win, const glfw_cpp::EventQueue&) { draw(win, gl); },
+            config.rate
+        );
+    }
+
+    pump_events(glfw, config.seconds);
+
+    for (auto& window : windows) {
+        window.request_close();
+    }
+    scheduler.wait();
+
+    auto time  = std::chrono::duration<double>{ Clock::now() - start }.count();
+    auto stats = scheduler.stats();
+
+    std::printf("scheduler: %zu steals\n", stats.steals);
+    return { .frames = stats.frames, .missed = stats.missed, .time = time };
+}
+
+Result run_thread_per_window(
+    glfw_cpp::Instance&            glfw,
+    std::vector<glfw_cpp::Window>& windows,
+    const Config&                  config
+)
+{
+    auto gl = load_gl(windows.front());
+
+    auto frames = std::atomic<std::size_t>{ 0 };
+    auto missed = std::atomic<std::size_t>{ 0 };
+    auto period = std::chrono::duration<double>{ 1.0 / config.rate };
+    auto step   = std::chrono::duration_cast<Clock::duration>(period);
+
+    auto start   = Clock::now();
+    auto threads = std::vector<std::jthread>{};
+
+    for (auto& window : windows) {
+        threads.emplace_back([&](std::stop_token stop) {
+            glfw_cpp::make_current(window.handle());
+            window.set_vsync(false);
+
+            auto deadline = Clock::now();
+            while (not stop.stop_requested()) {
+                std::this_thread::sleep_until(deadline);
+
+                auto now = Clock::now();
+                if (now > deadline + step) {
+                    ++missed;
+                }
+
+                window.swap_events();
+                draw(window, gl);
+                window.swap_buffers();
+                ++frames;
+
+                deadline += step;
+                if (deadline < now) {
+                    deadline = now + step;
+                }
+            }
+
+            glfw_cpp::make_current(nullptr);
+        });
+    }
+
+    pump_events(glfw, config.seconds);
+    threads.clear();    // request stop and join
+
+    auto time = std::chrono::duration<double>{ Clock::now() - start }.count();
+    return { .frames = frames, .missed = missed, .time = time };
+}
+
+void report(const char* name, const Result& result, const Config& config)
+{
+    auto fps      = static_cast<double>(result.frames) / result.time;
+    auto expected = config.rate * static_cast<double>(config.windows);
+
+    std::printf(
+        "%-18s: %8zu frames, %8.1f fps total (%5.1f%% of target), %6zu missed deadlines\n",
+        name,
+        result.frames,
+        fps,
+        100.0 * fps / expected,
+        result.missed
+    );
+}
+
+int main(int argc, char** argv)
+{
+    auto config = Config{};
+
+    // clang-format off
+    if (argc > 1) { config.windows = std::strtoul(argv[1], nullptr, 10); }
+    if (argc > 2) { config.threads = std::strtoul(argv[2], nullptr, 10); }
+    if (argc > 3) { config.rate    = std::strtod(argv[3], nullptr);      }
+    if (argc > 4) { config.seconds = std::strtod(argv[4], nullptr);      }
+    // clang-format on
+
+    auto glfw = glfw_cpp::init({ .platform = glfw_cpp::hint::Platform::Null });
+
+    glfw->set_error_callback([](glfw_cpp::ErrorCode code, std::string_view msg) {
+        fprintf(stderr, "glfw-cpp [%20s]: %s\n", to_string(code).data(), msg.data());
+    });
+
+    glfw->apply_hints({
+        .api = glfw_cpp::api::OpenGL{
+            .version_major = 3,
+            .version_minor = 3,
+            .profile       = glfw_cpp::gl::Profile::Core,
+            .creation_api  = glfw_cpp::gl::CreationApi::OSMesa,
+        },
+    });
+
+    auto create_windows = [&] {
+        auto windows = std::vector<glfw_cpp::Window>{};
+        windows.reserve(config.windows);
+        for (auto i : std::views::iota(0u, config.windows)) {
+            windows.push_back(glfw->create_window(64, 64, std::format("bench {}", i)));
+        }
+        return windows;
+    };
+
+    std::printf(
+        "%zu windows at %.1f fps for %.1f s, %zu render threads\n",
+        config.windows,
+        config.rate,
+        config.seconds,
+        config.threads
+    );
+
+    {
+        auto windows = create_windows();
+        auto result  = run_thread_per_window(*glfw, windows, config);
+        report("thread per window", result, config);
+    }
+
+    {
+        auto windows = create_windows();
+        auto result  = run_scheduler(*glfw, windows, config);
+        report("render scheduler", result, config);
+    }
+}
@@ -5,12 +5,14 @@
 #include <vulkan/vulkan.hpp>    // you need to include the vulkan header first
 
 #include <glfw_cpp/glfw_cpp.hpp>
-#include <glfw_cpp/vulkan.hpp>    // vulkan functionality for glfw_cpp is separated
+#include <glfw_cpp/vulkan.hpp>              // vulkan functionality for glfw_cpp is separated
+#include <glfw_cpp/vulkan_swapchain.hpp>    // swapchain recreation driven by window events
 
 #include <algorithm>
 #include <array>
 #include <cstddef>
 #include <cstring>
+#include <deque>
 #include <filesystem>
 #include <format>
 #include <fstream>
@@ -19,6 +21,7 @@
 #include <map>
 #include <optional>
 #include <set>
+#include <span>
 #include <stdexcept>
 #include <string>
 #include <tuple>
@@ -133,55 +136,6 @@ struct SwapChainSupportDetails
     std::vector<vk::PresentModeKHR>   m_presentModes;
 
     bool isAdequate() const { return !m_formats.empty() && !m_presentModes.empty(); }
-
-    vk::SurfaceFormatKHR chooseSurfaceFormat() const
-    {
-        // prefer srgb color space with 8-bit rgba
-        for (const auto& format : m_formats) {
-            if (format.format == vk::Format::eB8G8R8A8Srgb
-                && format.colorSpace == vk::ColorSpaceKHR::eSrgbNonlinear) {
-                return format;
-            }
-        }
-
-        // otherwise, just choose the first one
-        return m_formats.front();
-    }
-
-    vk::PresentModeKHR choosePresentMode() const
-    {
-        for (const auto& mode : m_presentModes) {
-            if (mode == vk::PresentModeKHR::eMailbox) {
-                return mode;
-            }
-        }
-
-        return vk::PresentModeKHR::eFifo;
-    }
-
-    vk::Extent2D chooseExtent(glfw_cpp::Window& window) const
-    {
-        // if the extent is not max uint32_t, then we can just use it
-        if (m_capabilities.currentExtent.width != std::numeric_limits<uint32_t>::max()) {
-            return m_capabilities.currentExtent;
-        }
-
-        // otherwise, set it manually
-        auto [width, height] = window.properties().dimensions;
-
-        return {
-            .width = std::clamp(
-                static_cast<uint32_t>(width),
-                m_capabilities.minImageExtent.width,
-                m_capabilities.maxImageExtent.width
-            ),
-            .height = std::clamp(
-                static_cast<uint32_t>(height),
-                m_capabilities.minImageExtent.height,
-                m_capabilities.maxImageExtent.height
-            ),
-        };
-    }
 };
 
 class DebugMessenger
@@ -307,23 +261,30 @@ public:
         m_graphicsQueue = m_device->getQueue(queueFamilies.m_graphicsFamily, 0);
         m_presentQueue  = m_device->getQueue(queueFamilies.m_presentFamily, 0);
 
-        // setup swap chain
-        std::tie(m_swapChain, m_swapChainImageFormat, m_swapChainExtent) = createSwapChain(
-            m_physicalDevice, *m_device, *m_surface, queueFamilies, *m_window
-        );
-
-        m_swapChainImages     = m_device->getSwapchainImagesKHR(*m_swapChain);
-        m_swapChainImageViews = createImageViews(*m_device, m_swapChainImages, m_swapChainImageFormat);
+        // setup swap chain; it gets recreated (debounced) on resize by glfw_cpp::vk::Swapchain
+        auto indices = queueFamilies.asArray();
+        m_swapchain  = glfw_cpp::vk::Swapchain{
+            *m_window,
+            {
+                .instance        = static_cast<VkInstance>(*m_instance),
+                .physical_device = static_cast<VkPhysicalDevice>(m_physicalDevice),
+                .device          = static_cast<VkDevice>(*m_device),
+                .surface         = static_cast<VkSurfaceKHR>(*m_surface),
+                .queue_families  = { indices.begin(), indices.end() },
+            },
+        };
+        m_swapchainGeneration = m_swapchain.generation();
 
         // create graphics pipeline
-        m_renderPass                                   = createRenderPass(*m_device, m_swapChainImageFormat);
+        auto format                                    = static_cast<vk::Format>(m_swapchain.format().format);
+        m_renderPass                                   = createRenderPass(*m_device, format);
         std::tie(m_pipelineLayout, m_graphicsPipeline) = createPipelineLayout(
             *m_device, *m_renderPass, bin_path
         );
 
         // create framebuffers
         m_swapChainFramebuffers = createFramebuffers(
-            *m_device, *m_renderPass, m_swapChainImageViews, m_swapChainExtent
+            *m_device, *m_renderPass, m_swapchain.image_views(), m_swapchain.extent()
         );
 
         m_commandPool    = createCommandPool(*m_device, queueFamilies);
@@ -337,6 +298,9 @@ public:
     {
         constexpr vk::ClearValue clearValue{ .color = { std::array{ 0.01F, 0.01F, 0.02F, 1.0F } } };
 
+        const auto [width, height] = m_swapchain.extent();
+        const auto extent          = vk::Extent2D{ .width = width, .height = height };
+
         vk::CommandBufferBeginInfo commandBeginInfo{
             .flags            = {},    //  use default flags
             .pInheritanceInfo = {},    //  only relevant for secondary command buffers
@@ -348,7 +312,7 @@ public:
             .framebuffer = *m_swapChainFramebuffers[imageIndex],
             .renderArea  = {
                  .offset = { 0, 0 },
-                 .extent = m_swapChainExtent,
+                 .extent = extent,
             },
             .clearValueCount = 1,
             .pClearValues    = &clearValue,
@@ -361,8 +325,8 @@ public:
         vk::Viewport viewport{
             .x        = 0.0F,
             .y        = 0.0F,
-            .width    = static_cast<float>(m_swapChainExtent.width),
-            .height   = static_cast<float>(m_swapChainExtent.height),
+            .width    = static_cast<float>(extent.width),
+            .height   = static_cast<float>(extent.height),
             .minDepth = 0.0F,
             .maxDepth = 1.0F,
         };
@@ -370,7 +334,7 @@ public:
 
         vk::Rect2D scissor{
             .offset = { 0, 0 },
-            .extent = m_swapChainExtent,
+            .extent = extent,
         };
         commandBuffer.setScissor(0, scissor);
 
@@ -381,6 +345,8 @@ public:
         commandBuffer.end();
     }
 
+    void processEvents(const glfw_cpp::EventQueue& events) { m_swapchain.process_events(events); }
+
     void drawFrame()
     {
         // wait forever, effectively disabling timeout
@@ -392,29 +358,18 @@ public:
             throw std::runtime_error(std::format("Failed to wait for fence: {}", vk::to_string(fenceResult)));
         }
 
-        // acquire image from swap chain
-        uint32_t imageIndex{};
-        switch (
-            auto [acquireResult, imageIndexTmp] = swapchainNextImageWrapper(
-                *m_device, *m_swapChain, timeoutNano, *m_syncs[m_currentFrameIndex].m_imageAvailableSemaphore
-            );
-            acquireResult
-        ) {
-        case vk::Result::eSuccess: {
-            imageIndex = imageIndexTmp;
-            break;
-        }
-        case vk::Result::eErrorOutOfDateKHR: [[fallthrough]];
-        case vk::Result::eSuboptimalKHR: {
-            recreateSwapChain();
-            return;
+        // acquire image from swap chain; the swapchain is recreated here when it's stale or out of date
+        auto& sync      = m_syncs[m_currentFrameIndex];
+        auto  available = static_cast<VkSemaphore>(*sync.m_imageAvailableSemaphore);
+        auto  image     = m_swapchain.acquire(available, VK_NULL_HANDLE, timeoutNano);
+        if (not image) {
+            return;    // the window is minimized, nothing to render
         }
-        default: {
-            throw std::runtime_error(
-                std::format("Failed to acquire swap chain image: {}", vk::to_string(acquireResult))
-            );
+
+        auto imageIndex = image->index;
+        if (m_swapchain.generation() != m_swapchainGeneration) {
+            updateFramebuffers();
         }
-        };
 
         m_device->resetFences(fences);
 
@@ -445,36 +400,28 @@ public:
             );
         }
 
-        // present image to screen
-        vk::PresentInfoKHR presentInfo{
-            .waitSemaphoreCount = 1,
-            .pWaitSemaphores    = &m_syncs[m_currentFrameIndex].m_renderFinishedSemaphore.get(),
-            .swapchainCount     = 1,
-            .pSwapchains        = &m_swapChain.get(),
-            .pImageIndices      = &imageIndex,
-            .pResults           = nullptr,
-        };
+        // present image to screen; out of date and suboptimal results are handled by the swapchain
+        auto queue  = static_cast<VkQueue>(m_presentQueue);
+        auto signal = static_cast<VkSemaphore>(*sync.m_renderFinishedSemaphore);
+        m_swapchain.present(queue, imageIndex, signal);
 
-        switch (auto presentResult = queuePresentWrapper(m_presentQueue, presentInfo); presentResult) {
-        case vk::Result::eSuccess: {
-            break;
-        }
-        case vk::Result::eErrorOutOfDateKHR: [[fallthrough]];
-        case vk::Result::eSuboptimalKHR: {
-            recreateSwapChain();
-            return;
-        }
-        default: {
-            throw std::runtime_error(
-                std::format("Failed to present swap chain image: {}", vk::to_string(presentResult))
-            );
+        // framebuffers of replaced swapchains are destroyed once the frames using them are done
+        ++m_frameCount;
+        while (not m_retiredFramebuffers.empty()
+               and m_retiredFramebuffers.front().m_destroyAt <= m_frameCount) {
+            m_retiredFramebuffers.pop_front();
         }
-        };
 
         m_currentFrameIndex = (m_currentFrameIndex + 1) % s_maxFramesInFlight;
     }
 
 private:
+    struct RetiredFramebuffers
+    {
+        std::vector<vk::UniqueFramebuffer> m_framebuffers;
+        std::uint64_t                      m_destroyAt;
+    };
+
     static constexpr bool        s_enableValidation  = ENABLE_VULKAN_VALIDATION_LAYERS;
     static constexpr std::array  s_validationLayers  = { "VK_LAYER_KHRONOS_validation" };
     static constexpr std::array  s_deviceExtensions  = { VK_KHR_SWAPCHAIN_EXTENSION_NAME };
@@ -492,12 +439,10 @@ private:
     vk::Queue m_graphicsQueue;
     vk::Queue m_presentQueue;
 
-    vk::UniqueSwapchainKHR             m_swapChain;
-    std::vector<vk::Image>             m_swapChainImages;
-    vk::Format                         m_swapChainImageFormat;
-    vk::Extent2D                       m_swapChainExtent;
-    std::vector<vk::UniqueImageView>   m_swapChainImageViews;
+    glfw_cpp::vk::Swapchain            m_swapchain;
+    std::uint64_t                      m_swapchainGeneration{ 0 };
     std::vector<vk::UniqueFramebuffer> m_swapChainFramebuffers;
+    std::deque<RetiredFramebuffers>    m_retiredFramebuffers;
 
     vk::UniqueRenderPass     m_renderPass;
     vk::UniquePipelineLayout m_pipelineLayout;
@@ -507,7 +452,8 @@ private:
     std::vector<vk::UniqueCommandBuffer> m_commandBuffers;
     std::vector<SyncObject>              m_syncs;
 
-    uint32_t m_currentFrameIndex{ 0 };
+    uint32_t      m_currentFrameIndex{ 0 };
+    std::uint64_t m_frameCount{ 0 };
 
     // NOTE: for some reason, I can't use the c++ bindings for this callback
     // (can't be assigned to vk::DebugUtilsMessengerCreateInfoEXT)
@@ -747,89 +693,6 @@ private:
         };
     }
 
-    static std::tuple<vk::UniqueSwapchainKHR, vk::Format, vk::Extent2D> createSwapChain(
-        const vk::PhysicalDevice& physicalDevice,
-        const vk::Device&         device,
-        const vk::SurfaceKHR&     surface,
-        const QueueFamilyIndices& queueIndices,
-        glfw_cpp::Window&         window
-    )
-    {
-        const auto swapChainSupport{ querySwapChainSupport(physicalDevice, surface) };
-        const auto surfaceFormat{ swapChainSupport.chooseSurfaceFormat() };
-        const auto presentMode{ swapChainSupport.choosePresentMode() };
-        const auto extent{ swapChainSupport.chooseExtent(window) };
-
-        uint32_t imageCount{ swapChainSupport.m_capabilities.minImageCount + 1 };
-        if (swapChainSupport.m_capabilities.maxImageCount > 0
-            && imageCount > swapChainSupport.m_capabilities.maxImageCount) {
-            imageCount = swapChainSupport.m_capabilities.maxImageCount;
-        }
-
-        vk::SwapchainCreateInfoKHR createInfo{
-            .surface          = surface,
-            .minImageCount    = imageCount,
-            .imageFormat      = surfaceFormat.format,
-            .imageColorSpace  = surfaceFormat.colorSpace,
-            .imageExtent      = extent,
-            .imageArrayLayers = 1,
-            .imageUsage       = vk::ImageUsageFlagBits::eColorAttachment,
-            .preTransform     = swapChainSupport.m_capabilities.currentTransform,
-            .compositeAlpha   = vk::CompositeAlphaFlagBitsKHR::eOpaque,
-            .presentMode      = presentMode,
-            .clipped          = VK_TRUE,
-            .oldSwapchain     = nullptr,
-        };
-
-        auto indices = queueIndices.asArray();
-        if (queueIndices.m_graphicsFamily != queueIndices.m_presentFamily) {
-            createInfo.imageSharingMode      = vk::SharingMode::eConcurrent;
-            createInfo.queueFamilyIndexCount = 2;
-            createInfo.pQueueFamilyIndices   = indices.data();
-        } else {
-            createInfo.imageSharingMode      = vk::SharingMode::eExclusive;
-            createInfo.queueFamilyIndexCount = 0;
-            createInfo.pQueueFamilyIndices   = nullptr;
-        }
-
-        auto swapChain{ device.createSwapchainKHRUnique(createInfo) };
-        return { std::move(swapChain), surfaceFormat.format, extent };
-    }
-
-    static std::vector<vk::UniqueImageView> createImageViews(
-        const vk::Device&             device,
-        const std::vector<vk::Image>& swapchainImages,
-        const vk::Format&             swapchainFormat
-    )
-    {
-        std::vector<vk::UniqueImageView> imageViews;
-        imageViews.reserve(swapchainImages.size());
-
-        for (const auto& image : swapchainImages) {
-            vk::ImageViewCreateInfo createInfo{
-                .image      = image,
-                .viewType   = vk::ImageViewType::e2D,
-                .format     = swapchainFormat,
-                .components = {
-                    .r = vk::ComponentSwizzle::eIdentity,
-                    .g = vk::ComponentSwizzle::eIdentity,
-                    .b = vk::ComponentSwizzle::eIdentity,
-                    .a = vk::ComponentSwizzle::eIdentity,
-                },
-                .subresourceRange = {
-                    .aspectMask     = vk::ImageAspectFlagBits::eColor,
-                    .baseMipLevel   = 0,
-                    .levelCount     = 1,
-                    .baseArrayLayer = 0,
-                    .layerCount     = 1,
-                },
-            };
-            imageViews.push_back(device.createImageViewUnique(createInfo));
-        }
-
-        return imageViews;
-    }
-
     static vk::UniqueRenderPass createRenderPass(
         const vk::Device& device,
         const vk::Format& swapChainImageFormat
@@ -1032,20 +895,22 @@ private:
     }
 
     static std::vector<vk::UniqueFramebuffer> createFramebuffers(
-        const vk::Device&                       device,
-        const vk::RenderPass&                   renderPass,
-        const std::vector<vk::UniqueImageView>& swapChainImageViews,
-        const vk::Extent2D&                     swapChainExtent
+        const vk::Device&            device,
+        const vk::RenderPass&        renderPass,
+        std::span<const VkImageView> swapChainImageViews,
+        const VkExtent2D&            swapChainExtent
     )
     {
         std::vector<vk::UniqueFramebuffer> framebuffers;
 
         framebuffers.reserve(swapChainImageViews.size());
-        for (const auto& imageView : swapChainImageViews) {
+        for (auto view : swapChainImageViews) {
+            auto imageView = vk::ImageView{ view };
+
             vk::FramebufferCreateInfo framebufferInfo{
                 .renderPass      = renderPass,
                 .attachmentCount = 1,
-                .pAttachments    = &imageView.get(),
+                .pAttachments    = &imageView,
                 .width           = swapChainExtent.width,
                 .height          = swapChainExtent.height,
                 .layers          = 1,
@@ -1104,59 +969,17 @@ private:
         return syncObjects;
     }
 
-    /**
-     * @brief vk::SwapchainKHR::acquireNextImageKHR without exceptions
-     */
-    static vk::ResultValue<uint32_t> swapchainNextImageWrapper(
-        const vk::Device&       device,
-        const vk::SwapchainKHR& swapchain,
-        uint64_t                timeoutNano,
-        vk::Semaphore           semaphore
-    )
+    void updateFramebuffers()
     {
-        uint32_t imageIndex;
-
-        auto result = vkAcquireNextImageKHR(
-            static_cast<VkDevice>(device),
-            static_cast<VkSwapchainKHR>(swapchain),
-            timeoutNano,
-            semaphore,
-            nullptr,
-            &imageIndex
-        );
-
-        return { static_cast<vk::Result>(result), imageIndex };
-    }
+        m_retiredFramebuffers.push_back({
+            .m_framebuffers = std::exchange(m_swapChainFramebuffers, {}),
+            .m_destroyAt    = m_frameCount + s_maxFramesInFlight,
+        });
 
-    /**
-     * @brief vk::Queue::presentKHR without exceptions
-     */
-    static vk::Result queuePresentWrapper(const vk::Queue& queue, const vk::PresentInfoKHR& presentInfo)
-    {
-        auto result = vkQueuePresentKHR(
-            static_cast<VkQueue>(queue), reinterpret_cast<const VkPresentInfoKHR*>(&presentInfo)
-        );
-        return static_cast<vk::Result>(result);
-    }
-
-    void recreateSwapChain()
-    {
-        m_device->waitIdle();
-
-        m_swapChainFramebuffers.clear();
-        m_swapChainImageViews.clear();
-        m_swapChain.reset();
-
-        // recreate swap chain
-        auto queueIndices{ QueueFamilyIndices::getCompleteQueueFamilies(m_physicalDevice, *m_surface) };
-        std::tie(m_swapChain, m_swapChainImageFormat, m_swapChainExtent) = createSwapChain(
-            m_physicalDevice, *m_device, *m_surface, queueIndices, *m_window
-        );
-        m_swapChainImages       = m_device->getSwapchainImagesKHR(*m_swapChain);
-        m_swapChainImageViews   = createImageViews(*m_device, m_swapChainImages, m_swapChainImageFormat);
         m_swapChainFramebuffers = createFramebuffers(
-            *m_device, *m_renderPass, m_swapChainImageViews, m_swapChainExtent
+            *m_device, *m_renderPass, m_swapchain.image_views(), m_swapchain.extent()
         );
+        m_swapchainGeneration = m_swapchain.generation();
     }
 };
 
@@ -1185,6 +1008,7 @@ int main(int, char** argv)
             }
         }
 
+        vulkan.processEvents(events);
         vulkan.drawFrame();
 
         window.swap_buffers();    // on NoApi, this function only updates delta time
@@ -0,0 +1,188 @@
+#ifndef GLFW_CPP_CAPTURE_HPP
+#define GLFW_CPP_CAPTURE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+
+namespace glfw_cpp
+{
+    class Window;
+}
+
+namespace glfw_cpp::capture
+{
+    /**
+     * @enum Format
+     * @brief Encoding of each frame written into the capture file.
+     */
+    enum class Format : std::uint32_t
+    {
+        Raw = 0,    // tightly packed RGBA8, top-to-bottom rows
+        Qoi = 1,    // a complete QOI image per frame (see https://qoiformat.org)
+    };
+
+    /**
+     * @struct FileHeader
+     * @brief Header written at the start of the capture file.
+     */
+    struct FileHeader
+    {
+        static constexpr std::uint32_t s_magic   = 0x50414347;    // "GCAP" in little-endian
+        static constexpr std::uint32_t s_version = 1;
+
+        std::uint32_t magic   = s_magic;
+        std::uint32_t version = s_version;
+    };
+
+    /**
+     * @struct FrameHeader
+     * @brief Header preceding every frame payload in the capture file.
+     *
+     * The payload immediately follows the header and is `payload_size` bytes long. Frames are laid out back
+     * to back so the file can be read sequentially.
+     */
+    struct FrameHeader
+    {
+        static constexpr std::uint32_t s_magic = 0x4D415246;    // "FRAM" in little-endian
+
+        std::uint32_t magic        = s_magic;
+        std::uint32_t width        = 0;
+        std::uint32_t height       = 0;
+        Format        format       = Format::Raw;
+        std::uint64_t timestamp_ns = 0;    // steady clock time at which the readback was issued
+        std::uint64_t payload_size = 0;
+    };
+
+    /**
+     * @struct Config
+     * @brief Configuration of a `FrameCapture`.
+     */
+    struct Config
+    {
+        std::filesystem::path path;                           // output file, truncated on open
+        Format                format    = Format::Qoi;         // encoding of each frame
+        std::size_t           ring_size = 4;                   // number of pixel buffer objects
+        std::size_t           reserve   = 64 * 1024 * 1024;    // initial size of the mapped file in bytes
+    };
+
+    /**
+     * @struct Stats
+     * @brief Counters of a `FrameCapture`.
+     */
+    struct Stats
+    {
+        std::size_t   issued  = 0;    // readbacks issued to the GPU
+        std::size_t   written = 0;    // frames encoded and written into the file
+        std::size_t   dropped = 0;    // frames skipped because every pixel buffer object was still busy
+        std::uint64_t bytes   = 0;    // total bytes written into the file (headers included)
+    };
+
+    /**
+     * @class FrameCapture
+     * @brief Asynchronous readback of the default framebuffer of a window into a memory-mapped file.
+     *
+     * The capture issues `glReadPixels` into a ring of pixel buffer objects so the read never blocks the
+     * render thread. A readback is only mapped once its fence is signaled (checked without waiting), then the
+     * mapped pointer is handed to a background encoder thread that writes the pixels into the output file
+     * directly; the render thread never copies pixel data. The buffer is unmapped and reused on a later call
+     * once the encoder is done with it. If every buffer is still busy the frame is dropped instead of
+     * stalling `Window::swap_buffers()`.
+     *
+     * Requires OpenGL 3.2 or OpenGL ES 3.0 (fence sync and buffer mapping). The capture works with any
+     * context creation API, including EGL and OSMesa on the Null platform, so it can run headless with Mesa
+     * llvmpipe.
+     *
+     * The object must be created, used, and destroyed on the thread the window context is current on. The
+     * window must outlive the capture and must not be moved while the capture is alive.
+     *
+     * ```cpp
+     * glfw_cpp::make_current(window.handle());
+     * auto capture = glfw_cpp::capture::FrameCapture{ window, { .path = "session.gcap" } };
+     *
+     * window.run([&](const auto& events) {
+     *     render(events);
+     *     capture.capture();    // call right before the buffers are swapped
+     * });
+     * ```
+     */
+    class FrameCapture
+    {
+    public:
+        /**
+         * @brief Create the capture, its pixel buffer objects, the output file, and the encoder thread.
+         *
+         * @param window The window whose default framebuffer will be captured.
+         * @param config The capture configuration.
+         *
+         * @throw error::NoCurrentContext If the window context is not current on the calling thread.
+         * @throw error::VersionUnavailable If the context lacks fence sync or buffer mapping.
+         * @throw error::PlatformError If the output file can't be created or mapped.
+         */
+        FrameCapture(const Window& window, Config config);
+
+        /**
+         * @brief Flush pending readbacks, stop the encoder thread, and truncate the file to its real size.
+         */
+        ~FrameCapture();
+
+        FrameCapture(FrameCapture&&) noexcept;
+        FrameCapture& operator=(FrameCapture&&) noexcept;
+        FrameCapture(const FrameCapture&)            = delete;
+        FrameCapture& operator=(const FrameCapture&) = delete;
+
+        /**
+         * @brief Issue a readback of the current back buffer and collect finished readbacks.
+         *
+         * Call this after rendering and before `Window::swap_buffers()`. This function never waits on the
+         * GPU.
+         */
+        void capture();
+
+        /**
+         * @brief Wait for every in-flight readback and hand them to the encoder.
+         *
+         * This function stalls the render thread; use it only at the end of a session.
+         */
+        void flush();
+
+        /**
+         * @brief Get the capture counters.
+         *
+         * @thread_safety This function can be called from any thread.
+         */
+        Stats stats() const noexcept;
+
+    private:
+        struct Impl;
+        std::unique_ptr<Impl> m_impl;
+    };
+}
+
+// frame encoders used by the capture, exposed for testing
+namespace glfw_cpp::capture::detail
+{
+    /**
+     * @brief Write tightly packed RGBA8 pixels, flipping the bottom-to-top rows of OpenGL.
+     *
+     * @return The number of bytes written, always `width * height * 4`.
+     */
+    std::size_t encode_raw(const std::byte* src, std::uint32_t width, std::uint32_t height, std::byte* dst);
+
+    /**
+     * @brief Get the largest size of a QOI image of the given dimensions.
+     */
+    std::size_t qoi_max_size(std::uint32_t width, std::uint32_t height);
+
+    /**
+     * @brief Encode RGBA8 pixels as a QOI image, flipping the bottom-to-top rows of OpenGL.
+     *
+     * @return The number of bytes written.
+     *
+     * The destination must have at least `qoi_max_size(width, height)` bytes available.
+     */
+    std::size_t encode_qoi(const std::byte* src, std::uint32_t width, std::uint32_t height, std::byte* dst);
+}
+
+#endif /* end of include guard: GLFW_CPP_CAPTURE_HPP */
@@ -0,0 +1,177 @@
+#ifndef GLFW_CPP_CLIPBOARD_HPP
+#define GLFW_CPP_CLIPBOARD_HPP
+
+#include "glfw_cpp/task.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace glfw_cpp
+{
+    class Instance;
+
+    /**
+     * @class ClipboardText
+     * @brief Immutable clipboard content, shared by every copy instead of duplicated.
+     *
+     * The text is copied once out of the GLFW buffer (which is only valid until the next clipboard call); the
+     * cache and every reader then refer to the same buffer, whatever its size.
+     */
+    class ClipboardText
+    {
+    public:
+        ClipboardText() = default;
+
+        explicit ClipboardText(std::shared_ptr<const std::string> text) noexcept
+            : m_text{ std::move(text) }
+        {
+        }
+
+        std::string_view view() const noexcept { return m_text ? *m_text : std::string_view{}; }
+        const char*      c_str() const noexcept { return m_text ? m_text->c_str() : ""; }
+        std::size_t      size() const noexcept { return m_text ? m_text->size() : 0; }
+        bool             empty() const noexcept { return size() == 0; }
+
+        operator std::string_view() const noexcept { return view(); }
+
+    private:
+        std::shared_ptr<const std::string> m_text;
+    };
+
+    /**
+     * @class Clipboard
+     * @brief Clipboard access from any thread, with a short-lived cache of the content.
+     *
+     * Reading the clipboard with GLFW must be done on the main thread and may block it on a round-trip to the
+     * selection owner (X11, Wayland). Here the reads are completed by the main thread as a task, and
+     * concurrent reads share a single round-trip.
+     *
+     * The cache is best-effort: GLFW does not report selection owner changes, and other applications
+     * (clipboard managers, sync tools, scripts) can change the clipboard at any time. A cached text is only
+     * served for `max_age()`; it is dropped earlier when the clipboard is set through this class (the cache
+     * takes the new text) or through `set_clipboard_string()`, when a window of the instance gains focus, or
+     * on `invalidate()`. Set the maximum age to zero to always read through GLFW.
+     *
+     * Failures of the clipboard calls are reported by the returned futures (or thrown by `get()`) whatever
+     * the `ErrorPolicy`; with `Deferred` and `CallbackOnly` they also go through the error callback as usual.
+     *
+     * Obtained with `Instance::clipboard()`.
+     */
+    class Clipboard
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        static constexpr std::chrono::milliseconds s_default_max_age = std::chrono::milliseconds{ 250 };
+
+        explicit Clipboard(Instance& instance) noexcept
+            : m_instance{ instance }
+        {
+        }
+
+        Clipboard(Clipboard&&)                 = delete;
+        Clipboard& operator=(Clipboard&&)      = delete;
+        Clipboard(const Clipboard&)            = delete;
+        Clipboard& operator=(const Clipboard&) = delete;
+
+        /**
+         * @brief Read the clipboard text asynchronously.
+         *
+         * @return The future text, already ready if the text is cached.
+         *
+         * @thread_safety This function can be called from any thread.
+         *
+         * The future throws `error::Error` if GLFW failed to read the clipboard. The text is empty if the
+         * clipboard is empty or does not hold text.
+         */
+        task::Future<ClipboardText> read();
+
+        /**
+         * @brief Read the clipboard text, blocking until the main thread has read it if it is not cached.
+         *
+         * @throw error::Error If GLFW failed to read the clipboard.
+         *
+         * @thread_safety This function can be called from any thread; on the main thread the clipboard is
+         * read directly.
+         */
+        ClipboardText get();
+
+        /**
+         * @brief Get the cached clipboard text, if any, without blocking.
+         *
+         * @thread_safety This function can be called from any thread.
+         */
+        std::optional<ClipboardText> cached() const;
+
+        /**
+         * @brief Set the clipboard text.
+         *
+         * @param text The text, moved into the cache.
+         *
+         * @return The completion of the change by the main thread.
+         *
+         * @thread_safety This function can be called from any thread.
+         *
+         * Reads see the new text right away. If GLFW fails to set it the cache is invalidated and the future
+         * throws `error::Error`.
+         */
+        task::Future<void> set(std::string text);
+
+        /**
+         * @brief Drop the cached text, the next read goes through GLFW.
+         *
+         * @thread_safety This function can be called from any thread.
+         */
+        void invalidate() noexcept;
+
+        /**
+         * @brief Set how long a cached text is served before the clipboard is read again.
+         *
+         * @param max_age The maximum age, zero disables the cache.
+         *
+         * @thread_safety This function can be called from any thread.
+         */
+        void set_max_age(std::chrono::milliseconds max_age) noexcept;
+
+        /**
+         * @brief Get how long a cached text is served, see `set_max_age()`.
+         */
+        std::chrono::milliseconds max_age() const noexcept;
+
+        /**
+         * @brief Get the number of times the cache was dropped or replaced.
+         *
+         * @thread_safety This function can be called from any thread.
+         */
+        std::uint64_t generation() const noexcept;
+
+    private:
+        /**
+         * @brief Read the clipboard through GLFW unless a previous task already cached it.
+         *
+         * Must be called on the main thread.
+         */
+        ClipboardText fetch();
+
+        /**
+         * @brief Get the cached text if it's not older than the maximum age; `m_mutex` must be held.
+         */
+        std::optional<ClipboardText> fresh_cache(Clock::time_point now) const;
+
+        Instance& m_instance;
+
+        mutable std::mutex           m_mutex;    // protects the members below
+        std::optional<ClipboardText> m_cache;
+        Clock::time_point            m_cached_at  = {};
+        std::chrono::milliseconds    m_max_age    = s_default_max_age;
+        std::uint64_t                m_generation = 0;
+    };
+}
+
+#endif /* end of include guard: GLFW_CPP_CLIPBOARD_HPP */
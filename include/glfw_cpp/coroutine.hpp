@@ -0,0 +1,514 @@
+#ifndef GLFW_CPP_COROUTINE_HPP
+#define GLFW_CPP_COROUTINE_HPP
+
+#include "glfw_cpp/event.hpp"
+#include "glfw_cpp/instance.hpp"
+#include "glfw_cpp/task.hpp"
+#include "glfw_cpp/window.hpp"
+
+#include <cassert>
+#include <concepts>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Coroutine layer over the window loop.
+ *
+ * A `co::Runner` drives the coroutines of one window on the render thread of that window. Each frame it
+ * swaps the window events, resumes the coroutines waiting for those events, then the ones waiting for the
+ * next frame; so any number of flows share the render thread without extra threads or state flags. A
+ * `task::Future` returned by `Instance::submit_task()` can be awaited as well.
+ *
+ * ```cpp
+ * glfw_cpp::co::Task intro(glfw_cpp::Instance& glfw, glfw_cpp::Window& window)
+ * {
+ *     auto click = co_await window.next<glfw_cpp::event::ButtonPressed>();
+ *
+ *     for (auto elapsed = 0.0; elapsed < 2.0; elapsed += window.delta_time()) {
+ *         draw_ripple(click, elapsed);
+ *         co_await window.next_frame();
+ *     }
+ *
+ *     auto monitor = co_await glfw.on_main_thread([] { return glfw_cpp::get_primary_monitor(); });
+ * }
+ *
+ * auto runner = glfw_cpp::co::Runner{ window };
+ * runner.spawn(intro(*glfw, window));
+ * runner.run([](const glfw_cpp::EventQueue&) { draw_background(); });
+ * ```
+ */
+namespace glfw_cpp::co
+{
+    class Runner;
+
+    /**
+     * @class Task
+     * @brief Coroutine type of the flows run by a `Runner`.
+     *
+     * A task starts suspended; it runs once spawned on a runner with `Runner::spawn()` or awaited by another
+     * task, in which case the awaiting task resumes when it finishes and gets its exception, if any.
+     */
+    class [[nodiscard]] Task
+    {
+    public:
+        struct promise_type;
+        using Handle = std::coroutine_handle<promise_type>;
+
+        struct promise_type
+        {
+            Runner*                 runner = nullptr;
+            std::coroutine_handle<> continuation;
+            std::exception_ptr      exception;
+
+            struct FinalAwaiter
+            {
+                bool await_ready() const noexcept { return false; }
+                void await_resume() const noexcept {}
+
+                std::coroutine_handle<> await_suspend(Handle handle) const noexcept
+                {
+                    if (auto next = handle.promise().continuation) {
+                        return next;
+                    }
+                    return std::noop_coroutine();
+                }
+            };
+
+            Task                get_return_object() noexcept { return Task{ Handle::from_promise(*this) }; }
+            std::suspend_always initial_suspend() const noexcept { return {}; }
+            FinalAwaiter        final_suspend() const noexcept { return {}; }
+            void                return_void() const noexcept {}
+            void                unhandled_exception() noexcept { exception = std::current_exception(); }
+        };
+
+        Task(Task&& other) noexcept
+            : m_handle{ std::exchange(other.m_handle, nullptr) }
+        {
+        }
+
+        Task& operator=(Task&& other) noexcept
+        {
+            if (this != &other) {
+                if (m_handle) {
+                    m_handle.destroy();
+                }
+                m_handle = std::exchange(other.m_handle, nullptr);
+            }
+            return *this;
+        }
+
+        Task(const Task&)            = delete;
+        Task& operator=(const Task&) = delete;
+
+        ~Task()
+        {
+            if (m_handle) {
+                m_handle.destroy();
+            }
+        }
+
+        /**
+         * @brief Run the task as part of the awaiting task, on the same runner.
+         */
+        auto operator co_await() && noexcept
+        {
+            struct Awaiter
+            {
+                Handle child;
+
+                bool await_ready() const noexcept { return not child or child.done(); }
+
+                std::coroutine_handle<> await_suspend(Handle parent) const noexcept
+                {
+                    child.promise().runner       = parent.promise().runner;
+                    child.promise().continuation = parent;
+                    return child;
+                }
+
+                void await_resume() const
+                {
+                    if (child and child.promise().exception) {
+                        std::rethrow_exception(child.promise().exception);
+                    }
+                }
+            };
+
+            return Awaiter{ m_handle };
+        }
+
+    private:
+        friend Runner;
+
+        explicit Task(Handle handle) noexcept
+            : m_handle{ handle }
+        {
+        }
+
+        Handle m_handle;
+    };
+
+    /**
+     * @class Runner
+     * @brief Resumes the tasks of a window frame by frame on the thread that ticks it.
+     *
+     * The runner and its tasks belong to the thread calling `spawn()`, `tick()`, and `run()` (usually the
+     * render thread of the window). Tasks awaiting a main thread task (`Instance::on_main_thread()` or a
+     * `task::Future`) are resumed on the first tick after it completed. Destroying the runner destroys the
+     * tasks still suspended.
+     */
+    class Runner
+    {
+    public:
+        explicit Runner(Window& window) noexcept
+            : m_window{ &window }
+        {
+        }
+
+        Runner(const Runner&)            = delete;
+        Runner& operator=(const Runner&) = delete;
+        Runner(Runner&&)                 = delete;
+        Runner& operator=(Runner&&)      = delete;
+
+        ~Runner()
+        {
+            // destroying the root frames destroys the tasks they were awaiting
+            for (auto handle : m_tasks) {
+                handle.destroy();
+            }
+        }
+
+        /**
+         * @brief Start a task, running it until its first suspension.
+         *
+         * @throw Any exception thrown by the task before its first suspension.
+         */
+        void spawn(Task task)
+        {
+            auto handle             = std::exchange(task.m_handle, nullptr);
+            handle.promise().runner = this;
+
+            m_tasks.push_back(handle);
+            handle.resume();
+            reap();
+        }
+
+        /**
+         * @brief Swap the window events and resume the tasks waiting for them or for the next frame.
+         *
+         * @return The events of the frame, same as `Window::swap_events()`.
+         *
+         * @throw Any exception that escaped a spawned task, the task is destroyed first.
+         *
+         * The tasks whose main thread task completed are resumed first, then each event is delivered to the
+         * tasks waiting for its type in queue order, then the tasks that were waiting for the next frame when
+         * the tick started are resumed. A task waiting again for an event type is resumed by the next event
+         * of that type in the same frame, if any; a task waiting for the next frame during the tick is
+         * resumed on the next tick.
+         */
+        const EventQueue& tick()
+        {
+            // only the waiters of the previous frames, the ones added while resuming wait for the next tick
+            m_frame_batch.swap(m_frame_waiters);
+
+            const auto& events = m_window->swap_events();
+            m_events           = &events;
+
+            if (not m_future_waiters.empty()) {
+                resume_completed();
+            }
+
+            if (not m_event_waiters.empty()) {
+                for (const auto& event : events) {
+                    deliver(event);
+                }
+            }
+
+            for (auto handle : m_frame_batch) {
+                handle.resume();
+            }
+            m_frame_batch.clear();
+
+            reap();
+            return events;
+        }
+
+        /**
+         * @brief Run the window loop until the window should close or every task finished.
+         *
+         * @param func The function to be called after the tasks were resumed and before swapping buffers.
+         *
+         * Like `Window::run()`, the window context is bound during the loop.
+         */
+        void run(std::invocable<const EventQueue&> auto&& func)
+        {
+            auto prev = glfw_cpp::get_current();
+            glfw_cpp::make_current(m_window->handle());
+
+            while (not m_window->should_close() and not empty()) {
+                func(tick());
+                m_window->swap_buffers();
+            }
+
+            glfw_cpp::make_current(prev);
+        }
+
+        void run()
+        {
+            run([](const EventQueue&) {});
+        }
+
+        /**
+         * @brief Check whether every spawned task finished.
+         */
+        bool empty() const noexcept { return m_tasks.empty(); }
+
+        /**
+         * @brief Get the window driven by this runner.
+         */
+        Window& window() const noexcept { return *m_window; }
+
+        /**
+         * @brief Get the events of the last tick, must not be called before the first one.
+         */
+        const EventQueue& events() const noexcept
+        {
+            assert(m_events != nullptr);
+            return *m_events;
+        }
+
+        // called by the awaiters
+        using Matcher = bool (*)(const Event&);
+
+        void wait_frame(std::coroutine_handle<> handle) { m_frame_waiters.push_back(handle); }
+
+        void wait_event(Matcher matches, std::optional<Event>* out, std::coroutine_handle<> handle)
+        {
+            m_event_waiters.push_back({ .matches = matches, .out = out, .handle = handle });
+        }
+
+        using Poller = bool (*)(const void*);
+
+        void wait_future(Poller ready, const void* future, std::coroutine_handle<> handle)
+        {
+            m_future_waiters.push_back({ .ready = ready, .future = future, .handle = handle });
+        }
+
+    private:
+        struct EventWaiter
+        {
+            Matcher                 matches;
+            std::optional<Event>*   out;
+            std::coroutine_handle<> handle;
+        };
+
+        struct FutureWaiter
+        {
+            Poller                  ready;
+            const void*             future;
+            std::coroutine_handle<> handle;
+        };
+
+        void resume_completed()
+        {
+            // one atomic load per pending future; tasks resumed here that await again are polled next tick
+            for (auto& waiter : m_future_waiters) {
+                if (waiter.ready(waiter.future)) {
+                    m_resuming.push_back(std::exchange(waiter.handle, nullptr));
+                }
+            }
+            std::erase_if(m_future_waiters, [](const FutureWaiter& waiter) { return not waiter.handle; });
+
+            resume_all();
+        }
+
+        void resume_all()
+        {
+            for (auto handle : m_resuming) {
+                handle.resume();
+            }
+            m_resuming.clear();
+        }
+
+        void deliver(const Event& event)
+        {
+            // waiters added while resuming are past `count` and wait for the next event
+            auto count = m_event_waiters.size();
+            for (std::size_t i = 0; i < count;) {
+                if (not m_event_waiters[i].matches(event)) {
+                    ++i;
+                    continue;
+                }
+
+                auto waiter = m_event_waiters[i];
+                m_event_waiters.erase(m_event_waiters.begin() + static_cast<std::ptrdiff_t>(i));
+                --count;
+
+                waiter.out->emplace(event);
+                waiter.handle.resume();
+            }
+        }
+
+        void reap()
+        {
+            auto exception = std::exception_ptr{};
+
+            for (std::size_t i = 0; i < m_tasks.size();) {
+                auto handle = m_tasks[i];
+                if (not handle.done()) {
+                    ++i;
+                    continue;
+                }
+
+                if (not exception) {
+                    exception = handle.promise().exception;
+                }
+                handle.destroy();
+
+                m_tasks[i] = m_tasks.back();
+                m_tasks.pop_back();
+            }
+
+            if (exception) {
+                std::rethrow_exception(exception);
+            }
+        }
+
+        Window*                              m_window;
+        const EventQueue*                    m_events = nullptr;    // events of the last tick
+        std::vector<Task::Handle>            m_tasks;               // the spawned tasks
+        std::vector<std::coroutine_handle<>> m_frame_waiters;
+        std::vector<std::coroutine_handle<>> m_frame_batch;    // frame waiters resumed by the current tick
+        std::vector<std::coroutine_handle<>> m_resuming;
+        std::vector<EventWaiter>             m_event_waiters;
+        std::vector<FutureWaiter>            m_future_waiters;
+    };
+
+    /**
+     * @class NextFrame
+     * @brief Awaiter returned by `Window::next_frame()`; resumes on the next tick with the frame events.
+     */
+    class NextFrame
+    {
+    public:
+        explicit NextFrame(Window& window) noexcept
+            : m_window{ &window }
+        {
+        }
+
+        bool await_ready() const noexcept { return false; }
+
+        void await_suspend(Task::Handle handle)
+        {
+            m_runner = handle.promise().runner;
+            assert(m_runner != nullptr and &m_runner->window() == m_window and "awaited on another runner");
+            m_runner->wait_frame(handle);
+        }
+
+        const EventQueue& await_resume() const noexcept { return m_runner->events(); }
+
+    private:
+        Window* m_window;
+        Runner* m_runner = nullptr;
+    };
+
+    /**
+     * @class NextEvent
+     * @brief Awaiter returned by `Window::next<E>()`; resumes with the next event of type `E`.
+     */
+    template <event::Event E>
+    class NextEvent
+    {
+    public:
+        explicit NextEvent(Window& window) noexcept
+            : m_window{ &window }
+        {
+        }
+
+        bool await_ready() const noexcept { return false; }
+
+        void await_suspend(Task::Handle handle)
+        {
+            auto* runner = handle.promise().runner;
+            assert(runner != nullptr and &runner->window() == m_window and "awaited on another runner");
+            runner->wait_event(&matches, &m_event, handle);
+        }
+
+        E await_resume() { return std::move(m_event->template get<E>()); }
+
+    private:
+        static bool matches(const Event& event) { return event.get_if<E>() != nullptr; }
+
+        Window*              m_window;
+        std::optional<Event> m_event;
+    };
+
+    /**
+     * @class FutureAwaiter
+     * @brief Awaiter of a `task::Future`, returned by `Instance::on_main_thread()`; resumes on the first tick
+     * of the runner after the main thread task completed, with its result.
+     */
+    template <typename T>
+    class FutureAwaiter
+    {
+    public:
+        explicit FutureAwaiter(task::Future<T> future) noexcept
+            : m_future{ std::move(future) }
+        {
+        }
+
+        bool await_ready() const noexcept { return m_future.ready(); }
+
+        void await_suspend(Task::Handle handle)
+        {
+            assert(handle.promise().runner != nullptr);
+            handle.promise().runner->wait_future(&ready, &m_future, handle);
+        }
+
+        T await_resume() { return m_future.get(); }
+
+    private:
+        static bool ready(const void* future) { return static_cast<const task::Future<T>*>(future)->ready(); }
+
+        task::Future<T> m_future;
+    };
+}
+
+namespace glfw_cpp
+{
+    inline co::NextFrame Window::next_frame() noexcept
+    {
+        return co::NextFrame{ *this };
+    }
+
+    template <event::Event E>
+    co::NextEvent<E> Window::next() noexcept
+    {
+        return co::NextEvent<E>{ *this };
+    }
+
+    template <typename Fn>
+        requires std::invocable<std::decay_t<Fn>&>
+    co::FutureAwaiter<task::ResultOf<Fn>> Instance::on_main_thread(Fn&& fn)
+    {
+        return co::FutureAwaiter<task::ResultOf<Fn>>{ submit_task(std::forward<Fn>(fn)) };
+    }
+
+    namespace task
+    {
+        /**
+         * @brief Await a future in a `co::Task`.
+         */
+        template <typename T>
+        co::FutureAwaiter<T> operator co_await(Future<T>&& future) noexcept
+        {
+            return co::FutureAwaiter<T>{ std::move(future) };
+        }
+    }
+}
+
+#endif /* end of include guard: GLFW_CPP_COROUTINE_HPP */
@@ -58,6 +58,34 @@ namespace glfw_cpp
         }
         // clang-format on
     }
+
+    /**
+     * @enum ErrorPolicy
+     * @brief How errors reported by GLFW are surfaced, selected at configure time with the CMake cache
+     * variable `GLFW_CPP_ERROR_POLICY`.
+     *
+     * - `Immediate`: the wrapped call checks `glfwGetError` and throws right away (the default).
+     * - `Deferred`: errors are collected by the error callback and thrown once by the next
+     *   `Instance::poll_events()` or `Instance::wait_events()`; wrapped calls never check `glfwGetError`.
+     * - `CallbackOnly`: errors are only reported to the callback set with `Instance::set_error_callback()`.
+     *
+     * Errors that make the call unable to return a value (e.g. window creation or initialization failure) are
+     * always thrown immediately.
+     */
+    enum class ErrorPolicy
+    {
+        Immediate,
+        Deferred,
+        CallbackOnly,
+    };
+
+#if defined(GLFW_CPP_ERROR_POLICY_DEFERRED)
+    inline constexpr ErrorPolicy error_policy = ErrorPolicy::Deferred;
+#elif defined(GLFW_CPP_ERROR_POLICY_CALLBACK_ONLY)
+    inline constexpr ErrorPolicy error_policy = ErrorPolicy::CallbackOnly;
+#else
+    inline constexpr ErrorPolicy error_policy = ErrorPolicy::Immediate;
+#endif
 }
 
 namespace glfw_cpp::error
@@ -72,6 +100,7 @@ namespace glfw_cpp::error
                   static_cast<int>(code),
                   std::format(fmt, std::forward<Args>(args)...)
               ) }
+            , m_code{ code }
         {
         }
 
@@ -5,12 +5,17 @@
 #include "glfw_cpp/input.hpp"
 #include "glfw_cpp/monitor.hpp"
 
+#include <array>
 #include <cstddef>
 #include <filesystem>
 #include <memory>
 #include <optional>
+#include <ranges>
+#include <span>
 #include <type_traits>
+#include <utility>
 #include <variant>
+#include <vector>
 
 namespace glfw_cpp
 {
@@ -273,6 +278,25 @@ namespace glfw_cpp
         {
             using Ts::operator()...;
         };
+
+        /**
+         * @brief Fold a resize event into an earlier one that is held back, see `resize::Policy`.
+         *
+         * @param pending The event held back.
+         * @param next The event that followed it.
+         *
+         * The size becomes the one of `next` and the change becomes the total change since the size that
+         * preceded `pending`.
+         */
+        template <typename E>
+            requires std::same_as<E, WindowResized> or std::same_as<E, FramebufferResized>
+        constexpr void coalesce(E& pending, const E& next) noexcept
+        {
+            pending.width          = next.width;
+            pending.height         = next.height;
+            pending.width_change  += next.width_change;
+            pending.height_change += next.height_change;
+        }
     }
 
     /**
@@ -387,10 +411,83 @@ namespace glfw_cpp
         virtual void on_monitor_connected(event::MonitorConnected) noexcept {};
     };
 
+    /**
+     * @brief Policies on what happens when an event is pushed to a full `EventQueue`, see
+     * `Window::set_overflow_policy()`.
+     */
+    namespace overflow
+    {
+        /**
+         * @struct Overwrite
+         * @brief The oldest event is overwritten by the new one (the default).
+         */
+        struct Overwrite
+        {
+        };
+
+        /**
+         * @struct Grow
+         * @brief The capacity is doubled until it reaches `max_capacity`, then the oldest event is
+         * overwritten.
+         */
+        struct Grow
+        {
+            std::size_t max_capacity = 4096;
+        };
+
+        /**
+         * @struct Reject
+         * @brief The new event is dropped, the queued events are kept.
+         */
+        struct Reject
+        {
+        };
+
+        using Policy = std::variant<Overwrite, Grow, Reject>;
+    }
+
+    /**
+     * @struct EventDrops
+     * @brief Number of events dropped because the queue (or its `PriorityLane`) was full, per event type.
+     */
+    struct EventDrops
+    {
+        using Traits = helper::variant::VariantTraits<event::Variant>;
+
+        std::array<std::size_t, Traits::size()> counts = {};    // indexed by `event::Variant` index
+
+        /**
+         * @brief Get the number of dropped events of type `E`.
+         */
+        template <event::Event E>
+        std::size_t count() const noexcept
+        {
+            return counts[Traits::type_index<E>()];
+        }
+
+        /**
+         * @brief Get the number of dropped events of all types.
+         */
+        std::size_t total() const noexcept
+        {
+            auto sum = std::size_t{ 0 };
+            for (auto count : counts) {
+                sum += count;
+            }
+            return sum;
+        }
+
+        void record(const Event& event) noexcept { ++counts[event.variant.index()]; }
+    };
+
     /**
      * @class EventQueue
      * @brief A simple event queue that stores events in a circular buffer. The queue is used to store events
      * in each `Window` instance. The queue has a fixed capacity that can be resized at runtime.
+     *
+     * The queue can optionally index its events by type (see `set_type_index()`), linking the events of each
+     * type in their queue order. `count<E>()` and `last<E>()` are then O(1) and `of_type<E>()` visits only
+     * the events of type `E`; without the index these functions scan the queue.
      */
     class EventQueue
     {
@@ -398,9 +495,15 @@ namespace glfw_cpp
         template <bool IsConst = false>
         class Iterator;
 
+        template <event::Event E>
+        class TypeIterator;
+
         friend class Iterator<false>;
         friend class Iterator<true>;
 
+        template <event::Event E>
+        friend class TypeIterator;
+
         enum class ResizePolicy
         {
             DiscardOld,
@@ -437,9 +540,25 @@ namespace glfw_cpp
 
         /**
          * @brief Get a view of the underlying buffer as a `std::span`
+         *
+         * The buffer is in storage order; use `segments()` for the queued events in queue order.
          */
         std::span<const Event> buf() const noexcept { return { m_buffer.get(), capacity() }; }
 
+        /**
+         * @brief Get the queued events in queue order as at most two contiguous segments
+         *
+         * @return The events from the front of the queue up to the end of the buffer, then the events that
+         * wrapped around to the start of the buffer (empty if none did).
+         *
+         * ```cpp
+         * for (auto segment : queue.segments()) {
+         *     for (const auto& event : segment) { ... }
+         * }
+         * ```
+         */
+        std::array<std::span<const Event>, 2> segments() const noexcept;
+
         /**
          * @brief Get the capacity of the queue
          */
@@ -485,6 +604,15 @@ namespace glfw_cpp
          */
         Iterator<> push(Event&& event) noexcept;
 
+        /**
+         * @brief Push an event to the queue, handling a full queue according to the policy
+         *
+         * @param event Event to push
+         * @param policy What to do if the queue is full
+         * @return The event dropped to make room (or `event` itself for `overflow::Reject`), if any
+         */
+        std::optional<Event> push(Event&& event, const overflow::Policy& policy) noexcept;
+
         /**
          * @brief Pop an event from the queue
          *
@@ -492,6 +620,14 @@ namespace glfw_cpp
          */
         std::optional<Event> pop() noexcept;
 
+        /**
+         * @brief Move events from the front of the queue into `out` and remove them from the queue
+         *
+         * @param out Destination of the events, in queue order
+         * @return The number of events moved, at most `out.size()`
+         */
+        std::size_t drain_into(std::span<Event> out) noexcept;
+
         /**
          * @brief Resize the queue to the specified capacity
          *
@@ -500,6 +636,42 @@ namespace glfw_cpp
          */
         void resize(std::size_t new_capacity, ResizePolicy policy = ResizePolicy::DiscardOld) noexcept;
 
+        /**
+         * @brief Enable or disable the index of the events by type
+         *
+         * @param enabled Whether to maintain the index
+         *
+         * The index costs one `std::size_t` per slot and a few writes per push and pop.
+         */
+        void set_type_index(bool enabled) noexcept;
+
+        /**
+         * @brief Check whether the events are indexed by type
+         */
+        bool has_type_index() const noexcept { return m_next != nullptr; }
+
+        /**
+         * @brief Get the number of events of type `E` in the queue
+         */
+        template <event::Event E>
+        std::size_t count() const noexcept;
+
+        /**
+         * @brief Get the most recent event of type `E` in the queue, or null if there is none
+         */
+        template <event::Event E>
+        const E* last() const noexcept;
+
+        /**
+         * @brief Get a view of the events of type `E` in queue order
+         *
+         * ```cpp
+         * for (const auto& key : queue.of_type<event::KeyPressed>()) { handle(key); }
+         * ```
+         */
+        template <event::Event E>
+        std::ranges::subrange<TypeIterator<E>> of_type() const noexcept;
+
         Iterator<>     begin() noexcept;
         Iterator<>     end() noexcept;
         Iterator<true> begin() const noexcept;
@@ -508,10 +680,32 @@ namespace glfw_cpp
         Iterator<true> cend() const noexcept;
 
     private:
+        using Traits = helper::variant::VariantTraits<event::Variant>;
+
+        // the events of one type, linked through m_next in queue order
+        struct Lane
+        {
+            std::size_t head  = npos;
+            std::size_t tail  = npos;
+            std::size_t count = 0;
+        };
+
+        void link_back(std::size_t index) noexcept;
+        void unlink(std::size_t index) noexcept;    // index must hold the oldest event of its type
+        void rebuild_type_index() noexcept;    // after the capacity changed
+        void relink_type_index() noexcept;
+
+        // ring position of the event at offset from the front
+        std::size_t at(std::size_t offset) const noexcept { return (m_begin + offset) % capacity(); }
+
         std::unique_ptr<Event[]> m_buffer   = nullptr;
         std::size_t              m_capacity = 0;
         std::size_t              m_begin    = 0;
         std::size_t              m_end      = 0;
+
+        // type index, m_next is null when disabled
+        std::unique_ptr<std::size_t[]>   m_next  = nullptr;
+        std::array<Lane, Traits::size()> m_lanes = {};
     };
 
     template <bool IsConst>
@@ -597,12 +791,178 @@ namespace glfw_cpp
     static_assert(std::forward_iterator<EventQueue::Iterator<false>>);
     static_assert(std::forward_iterator<EventQueue::Iterator<true>>);
 
+    /**
+     * @class EventQueue::TypeIterator
+     * @brief Iterator over the events of type `E` of an `EventQueue`, see `EventQueue::of_type()`.
+     *
+     * Follows the type index if the queue has one, otherwise skips the events of other types.
+     */
+    template <event::Event E>
+    class EventQueue::TypeIterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = E;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = const E*;
+        using reference         = const E&;
+
+        TypeIterator() noexcept = default;
+
+        // begin iterator, or end iterator if `end` is true
+        TypeIterator(const EventQueue* queue, bool end) noexcept
+            : m_queue{ queue }
+        {
+            if (end) {
+                return;
+            }
+
+            if (m_queue->has_type_index()) {
+                m_index = m_queue->m_lanes[type].head;
+            } else {
+                seek();
+            }
+        }
+
+        TypeIterator& operator++() noexcept
+        {
+            if (m_queue->has_type_index()) {
+                m_index = m_queue->m_next[m_index];
+            } else {
+                ++m_offset;
+                seek();
+            }
+            return *this;
+        }
+
+        TypeIterator operator++(int) noexcept
+        {
+            auto tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        const E& operator*() const noexcept { return *m_queue->m_buffer[m_index].template get_if<E>(); }
+        const E* operator->() const noexcept { return m_queue->m_buffer[m_index].template get_if<E>(); }
+
+        bool operator==(const TypeIterator& other) const noexcept
+        {
+            return m_queue == other.m_queue and m_index == other.m_index;
+        }
+
+    private:
+        static constexpr std::size_t type = Traits::type_index<E>();
+
+        // move m_offset to the next event of type E (scan mode)
+        void seek() noexcept
+        {
+            auto size = m_queue->size();
+            while (m_offset < size and not m_queue->m_buffer[m_queue->at(m_offset)].template is<E>()) {
+                ++m_offset;
+            }
+            m_index = m_offset < size ? m_queue->at(m_offset) : npos;
+        }
+
+        const EventQueue* m_queue  = nullptr;
+        std::size_t       m_index  = npos;
+        std::size_t       m_offset = 0;
+    };
+
+    static_assert(std::forward_iterator<EventQueue::TypeIterator<event::KeyPressed>>);
+
+    template <event::Event E>
+    std::size_t EventQueue::count() const noexcept
+    {
+        if (has_type_index()) {
+            return m_lanes[Traits::type_index<E>()].count;
+        }
+        return static_cast<std::size_t>(std::ranges::distance(of_type<E>()));
+    }
+
+    template <event::Event E>
+    const E* EventQueue::last() const noexcept
+    {
+        if (has_type_index()) {
+            auto tail = m_lanes[Traits::type_index<E>()].tail;
+            return tail == npos ? nullptr : m_buffer[tail].template get_if<E>();
+        }
+        for (auto offset = size(); offset-- > 0;) {
+            if (auto* event = m_buffer[at(offset)].template get_if<E>()) {
+                return event;
+            }
+        }
+        return nullptr;
+    }
+
+    template <event::Event E>
+    std::ranges::subrange<EventQueue::TypeIterator<E>> EventQueue::of_type() const noexcept
+    {
+        return { TypeIterator<E>{ this, false }, TypeIterator<E>{ this, true } };
+    }
+
+    /**
+     * @class PriorityLane
+     * @brief Side lane of an `EventQueue` for state-critical events, so that they are never evicted.
+     *
+     * Window close and focus changes, key and mouse button releases, and file drops are kept in the lane
+     * instead of the queue; a flood of other events (e.g. `CursorMoved`) overflowing the queue can't evict
+     * them. Each event in the lane remembers how many events were pushed to the queue before it, and
+     * `swap_merged()` interleaves the lane back with the queue in the order the events were pushed.
+     *
+     * The lane is a fixed array of `s_reserved` events, so pushing never allocates. Once it is full, a
+     * `WindowClosed` or `WindowFocused` replaces the last one of its type in the lane (only the latest state
+     * matters); other critical events are dropped and returned to the caller like the overflow of the queue.
+     */
+    class PriorityLane
+    {
+    public:
+        static constexpr std::size_t s_reserved = 16;
+
+        /**
+         * @brief Check whether the event goes to the lane.
+         */
+        static bool is_critical(const Event& event) noexcept;
+
+        /**
+         * @brief Push an event to the lane if it is critical, to `queue` otherwise.
+         *
+         * @param queue The queue the lane belongs to.
+         * @param event The event to push.
+         * @param policy What to do if `queue` is full.
+         * @return The event dropped from `queue` or from the full lane, if any.
+         */
+        std::optional<Event> push(EventQueue& queue, Event&& event, const overflow::Policy& policy) noexcept;
+
+        /**
+         * @brief Move the events of `queue` and of the lane to `out` in the order they were pushed.
+         *
+         * @param queue The queue the lane belongs to, emptied.
+         * @param out The destination queue, its previous events are discarded and it grows if needed.
+         *
+         * Without events in the lane, this is only a swap of the queues.
+         */
+        void swap_merged(EventQueue& queue, EventQueue& out) noexcept;
+
+        std::size_t size() const noexcept { return m_size; }
+        bool        empty() const noexcept { return m_size == 0; }
+
+    private:
+        std::optional<Event> push_critical(Event&& event) noexcept;
+
+        // each event with the number of events pushed to the queue before it
+        std::array<std::pair<std::size_t, Event>, s_reserved> m_events = {};
+        std::size_t                                           m_size   = 0;
+        std::size_t                                           m_pushed = 0;    // events pushed to the queue
+    };
+
     // NOTE: the visit function must be defined in the header since it's a template
     template <helper::variant::ConstVisitorComplete<event::Variant> T>
     void EventQueue::visit(T&& visitor) const
     {
-        for (const auto& event : *this) {
-            event.visit(visitor);
+        for (auto segment : segments()) {
+            for (const auto& event : segment) {
+                event.visit(visitor);
+            }
         }
     }
 }
@@ -0,0 +1,100 @@
+#ifndef GLFW_CPP_EXTENSION_SET_HPP
+#define GLFW_CPP_EXTENSION_SET_HPP
+
+#include "glfw_cpp/instance.hpp"
+
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace glfw_cpp::gl
+{
+    /**
+     * @class ExtensionSet
+     * @brief Hashed set of the extensions supported by an OpenGL or OpenGL ES context.
+     *
+     * The context extensions are enumerated once on construction (with `glGetStringi` on version 3.0 and
+     * later, by splitting `GL_EXTENSIONS` before that), so `contains()` is a single hash lookup instead of
+     * the string scan done by `glfwExtensionSupported`.
+     *
+     * Platform extensions (`WGL_*`, `GLX_*`, `EGL_*`, ...) are not part of the context extension list; they
+     * are queried through `glfwExtensionSupported` on first use and remembered afterwards. The set is shared
+     * by every thread the context is made current on, so the remembered platform extensions are guarded by
+     * a mutex.
+     */
+    class ExtensionSet
+    {
+    public:
+        /**
+         * @brief Enumerate the extensions of the current context.
+         *
+         * @param loader The function resolving the query functions, or `nullptr` for `glfwGetProcAddress`.
+         *
+         * @throw error::NoCurrentContext If no context is current on the calling thread.
+         */
+        explicit ExtensionSet(GetProc* loader = nullptr);
+
+        ExtensionSet(const ExtensionSet&)            = delete;
+        ExtensionSet& operator=(const ExtensionSet&) = delete;
+
+        /**
+         * @brief Check whether the extension is supported.
+         *
+         * @param extension The name of the extension.
+         *
+         * Must be called on a thread the context of this set is current on (only for platform extensions the
+         * first time they are looked up).
+         */
+        bool contains(std::string_view extension) const;
+
+        /**
+         * @brief Get the number of context extensions.
+         */
+        std::size_t size() const noexcept { return m_extensions.size(); }
+
+        const std::unordered_set<std::string_view>& extensions() const noexcept { return m_extensions; }
+
+    private:
+        std::string                                   m_names;         // storage for the views
+        std::unordered_set<std::string_view>          m_extensions;    // views into m_names
+        mutable std::unordered_map<std::string, bool> m_platform;    // protected by m_platform_mutex
+        mutable std::mutex                            m_platform_mutex;
+    };
+
+    /**
+     * @brief Get the extension set of the current context.
+     *
+     * @throw error::NoCurrentContext If no context is current on the calling thread.
+     *
+     * The set is built on the first call for each context and kept until its window is destroyed. The last
+     * set used by each thread is remembered, so repeated calls with the same context current only compare a
+     * pointer.
+     */
+    const ExtensionSet& current_extensions();
+
+    /**
+     * @brief Get the extension set of a context current on the calling thread, enumerated through a loader.
+     *
+     * @param context The window whose context is current.
+     * @param loader The function resolving the query functions, or `nullptr` for `glfwGetProcAddress`.
+     *
+     * Same as the other overload, for contexts whose procedures are resolved by another loader; the sets are
+     * shared with it.
+     */
+    const ExtensionSet& current_extensions(GLFWwindow* context, GetProc* loader);
+
+    /**
+     * @brief Drop the extension set of a context.
+     *
+     * @param context The window whose context the set belongs to.
+     *
+     * Called when a window is destroyed; references returned by `current_extensions()` for the context are
+     * invalidated.
+     */
+    void forget_extensions(GLFWwindow* context) noexcept;
+}
+
+#endif /* end of include guard: GLFW_CPP_EXTENSION_SET_HPP */
@@ -91,9 +91,32 @@ namespace glfw_cpp
     struct CursorPosition;
     struct Attributes;
     struct Properties;
+    struct Snapshot;
     class Window;
     // ----------
 
+    // window_registry.hpp
+    // -------------------
+    struct WindowId;
+    class WindowRegistry;
+    // -------------------
+
+    // task.hpp
+    // --------
+    namespace task
+    {
+        template <typename T>
+        class Future;
+        struct LatencyStats;
+    }
+    // --------
+
+    // clipboard.hpp
+    // -------------
+    class ClipboardText;
+    class Clipboard;
+    // -------------
+
     // instance.hpp
     // ------------
     namespace gl
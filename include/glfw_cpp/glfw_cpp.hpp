@@ -6,6 +6,7 @@
 #include "glfw_cpp/input.hpp"
 #include "glfw_cpp/instance.hpp"
 #include "glfw_cpp/monitor.hpp"
+#include "glfw_cpp/result.hpp"
 #include "glfw_cpp/window.hpp"
 
 #endif /* end of include guard: GLFW_CPP_GLFW_CPP_HPP */
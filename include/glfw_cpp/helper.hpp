@@ -1,7 +1,12 @@
 #ifndef GLFW_CPP_HELPER_HPP
 #define GLFW_CPP_HELPER_HPP
 
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <concepts>
+#include <cstdint>
+#include <cstring>
 #include <optional>
 #include <type_traits>
 #include <utility>
@@ -157,4 +162,157 @@ namespace glfw_cpp::helper::meta
     }
 }
 
+namespace glfw_cpp::helper::sync
+{
+    /**
+     * @class SeqLock
+     * @brief Single writer, multiple readers publication of a trivially copyable value.
+     *
+     * The writer bumps the sequence to odd, stores the value, then bumps it to even again. Readers copy the
+     * value and retry if the sequence was odd or changed meanwhile, so they never block the writer nor each
+     * other. The value is stored as relaxed atomic words, so a torn copy is discarded instead of being a
+     * data race.
+     *
+     * Concurrent calls to `store()` must be serialized by the caller.
+     *
+     * @tparam T The published type.
+     */
+    template <typename T>
+        requires std::is_trivially_copyable_v<T> and std::default_initializable<T>
+    class SeqLock
+    {
+    public:
+        SeqLock() noexcept { store(T{}); }
+
+        explicit SeqLock(const T& value) noexcept { store(value); }
+
+        SeqLock(const SeqLock& other) noexcept { store(other.load()); }
+
+        SeqLock& operator=(const SeqLock& other) noexcept
+        {
+            if (this != &other) {
+                store(other.load());
+            }
+            return *this;
+        }
+
+        /**
+         * @brief Publish a new value.
+         */
+        void store(const T& value) noexcept
+        {
+            auto words = Words{};
+            std::memcpy(words.data(), &value, sizeof(T));
+
+            auto seq = m_seq.load(std::memory_order::relaxed);
+            m_seq.store(seq + 1, std::memory_order::relaxed);
+            std::atomic_thread_fence(std::memory_order::release);
+
+            for (std::size_t i = 0; i < s_word_count; ++i) {
+                m_words[i].store(words[i], std::memory_order::relaxed);
+            }
+
+            m_seq.store(seq + 2, std::memory_order::release);
+        }
+
+        /**
+         * @brief Get a consistent copy of the latest published value.
+         */
+        T load() const noexcept
+        {
+            auto words = Words{};
+
+            while (true) {
+                auto before = m_seq.load(std::memory_order::acquire);
+                for (std::size_t i = 0; i < s_word_count; ++i) {
+                    words[i] = m_words[i].load(std::memory_order::relaxed);
+                }
+                std::atomic_thread_fence(std::memory_order::acquire);
+
+                if ((before & 1) == 0 and m_seq.load(std::memory_order::relaxed) == before) {
+                    break;
+                }
+            }
+
+            auto value = T{};
+            std::memcpy(static_cast<void*>(&value), words.data(), sizeof(T));    // T is trivially copyable
+            return value;
+        }
+
+        /**
+         * @brief Get the version of the published value, it changes on every `store()`.
+         */
+        std::uint64_t version() const noexcept { return m_seq.load(std::memory_order::acquire) / 2; }
+
+    private:
+        static constexpr std::size_t s_word_size  = sizeof(std::uint64_t);
+        static constexpr std::size_t s_word_count = (sizeof(T) + s_word_size - 1) / s_word_size;
+
+        using Words = std::array<std::uint64_t, s_word_count>;
+
+        std::atomic<std::uint64_t>                           m_seq   = 0;    // odd while a store is ongoing
+        std::array<std::atomic<std::uint64_t>, s_word_count> m_words = {};
+    };
+}
+
+namespace glfw_cpp::helper::time
+{
+    /**
+     * @class Debouncer
+     * @brief Pending action carried out once its trigger has been quiet for a period.
+     *
+     * `poke()` restarts the quiet period, for triggers that stop on their own (e.g. resize events).
+     * `request()` only starts it if nothing is pending yet, for conditions that are reported again and again
+     * until the action is carried out (e.g. a suboptimal swapchain); restarting the period on those would
+     * postpone the action forever. `expedite()` makes the action due right away.
+     *
+     * The time points are parameters so that the state can be driven by a fake clock.
+     */
+    class Debouncer
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        void poke(Clock::time_point now = Clock::now()) noexcept
+        {
+            m_pending = true;
+            m_since   = now;
+        }
+
+        void request(Clock::time_point now = Clock::now()) noexcept
+        {
+            if (not m_pending) {
+                poke(now);
+            }
+        }
+
+        void expedite() noexcept
+        {
+            m_pending = true;
+            m_urgent  = true;
+        }
+
+        void clear() noexcept
+        {
+            m_pending = false;
+            m_urgent  = false;
+        }
+
+        bool pending() const noexcept { return m_pending; }
+
+        /**
+         * @brief Check whether the action is pending and its trigger has been quiet for `quiet`.
+         */
+        bool due(Clock::duration quiet, Clock::time_point now = Clock::now()) const noexcept
+        {
+            return m_pending and (m_urgent or now - m_since >= quiet);
+        }
+
+    private:
+        Clock::time_point m_since   = {};
+        bool              m_pending = false;
+        bool              m_urgent  = false;
+    };
+}
+
 #endif /* end of include guard: GLFW_CPP_HELPER_HPP */
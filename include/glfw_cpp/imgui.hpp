@@ -2,18 +2,28 @@
 #define GLFW_CPP_IMGUI_HPP
 
 #include "glfw_cpp/event.hpp"
+#include "glfw_cpp/window.hpp"
 
+#include <algorithm>
 #include <cassert>
+#include <cfloat>
 #include <utility>
 
+#if __has_include(<imgui.h>)
+    #include <imgui.h>
+#else
+    #error "This file requires imgui.h to be exists and visible."
+#endif
+
+// only the `ImGui_ImplGlfw` based functions need the backend, the `direct` bridge doesn't
 #if __has_include(<imgui_impl_glfw.h>)
     #include <imgui_impl_glfw.h>
-#else
-    #error "This file requires imgui_impl_glfw.h to be exists and visible."
+    #define GLFW_CPP_IMGUI_IMPL_GLFW 1
 #endif
 
 struct GLFWwindow;
 
+#if GLFW_CPP_IMGUI_IMPL_GLFW
 namespace glfw_cpp::imgui
 {
     /**
@@ -123,5 +133,276 @@ namespace glfw_cpp::imgui
         ImGui_ImplGlfw_Shutdown();
     }
 }
+#endif
+
+/**
+ * @brief Platform backend that feeds `ImGuiIO` straight from the window event queue.
+ *
+ * The `ImGui_ImplGlfw` callbacks used by the functions above query GLFW again (modifier keys, the window
+ * size, the cursor, ...) which must be done on the main thread. This bridge only uses the data carried by the
+ * events and the properties already recorded by the `Window`, so it can run on the render thread of the
+ * window with its own imgui context, without any GLFW call:
+ *
+ * ```cpp
+ * ImGui::CreateContext();
+ * glfw_cpp::imgui::direct::init(ImGui::GetIO());
+ *
+ * while (not window.should_close()) {
+ *     const auto& events = window.swap_events();
+ *     glfw_cpp::imgui::direct::process_events(ImGui::GetIO(), events);
+ *     glfw_cpp::imgui::direct::new_frame(ImGui::GetIO(), window);
+ *     ImGui::NewFrame();
+ *     // ...
+ * }
+ *
+ * glfw_cpp::imgui::direct::shutdown(ImGui::GetIO());
+ * ```
+ *
+ * Keys are mapped by their `KeyCode` (the US layout position), mouse cursor shapes and gamepads are not
+ * handled.
+ */
+namespace glfw_cpp::imgui::direct
+{
+    /**
+     * @brief Map a `KeyCode` to an `ImGuiKey`.
+     *
+     * @return The corresponding key, or `ImGuiKey_None` if there is none.
+     */
+    constexpr ImGuiKey to_imgui_key(KeyCode key) noexcept
+    {
+        using K = KeyCode;
+
+        // clang-format off
+        switch (key) {
+        case K::Tab:            return ImGuiKey_Tab;
+        case K::Left:           return ImGuiKey_LeftArrow;
+        case K::Right:          return ImGuiKey_RightArrow;
+        case K::Up:             return ImGuiKey_UpArrow;
+        case K::Down:           return ImGuiKey_DownArrow;
+        case K::PageUp:         return ImGuiKey_PageUp;
+        case K::PageDown:       return ImGuiKey_PageDown;
+        case K::Home:           return ImGuiKey_Home;
+        case K::End:            return ImGuiKey_End;
+        case K::Insert:         return ImGuiKey_Insert;
+        case K::Delete:         return ImGuiKey_Delete;
+        case K::Backspace:      return ImGuiKey_Backspace;
+        case K::Space:          return ImGuiKey_Space;
+        case K::Enter:          return ImGuiKey_Enter;
+        case K::Escape:         return ImGuiKey_Escape;
+        case K::Apostrophe:     return ImGuiKey_Apostrophe;
+        case K::Comma:          return ImGuiKey_Comma;
+        case K::Minus:          return ImGuiKey_Minus;
+        case K::Period:         return ImGuiKey_Period;
+        case K::Slash:          return ImGuiKey_Slash;
+        case K::Semicolon:      return ImGuiKey_Semicolon;
+        case K::Equal:          return ImGuiKey_Equal;
+        case K::LeftBracket:    return ImGuiKey_LeftBracket;
+        case K::BackSlash:      return ImGuiKey_Backslash;
+        case K::RightBracket:   return ImGuiKey_RightBracket;
+        case K::GraveAccent:    return ImGuiKey_GraveAccent;
+        case K::CapsLock:       return ImGuiKey_CapsLock;
+        case K::ScrollLock:     return ImGuiKey_ScrollLock;
+        case K::NumLock:        return ImGuiKey_NumLock;
+        case K::PrintScreen:    return ImGuiKey_PrintScreen;
+        case K::Pause:          return ImGuiKey_Pause;
+        case K::KeypadDecimal:  return ImGuiKey_KeypadDecimal;
+        case K::KeypadDivide:   return ImGuiKey_KeypadDivide;
+        case K::KeypadMultiply: return ImGuiKey_KeypadMultiply;
+        case K::KeypadSubtract: return ImGuiKey_KeypadSubtract;
+        case K::KeypadAdd:      return ImGuiKey_KeypadAdd;
+        case K::KeypadEnter:    return ImGuiKey_KeypadEnter;
+        case K::KeypadEqual:    return ImGuiKey_KeypadEqual;
+        case K::LeftShift:      return ImGuiKey_LeftShift;
+        case K::LeftControl:    return ImGuiKey_LeftCtrl;
+        case K::LeftAlt:        return ImGuiKey_LeftAlt;
+        case K::LeftSuper:      return ImGuiKey_LeftSuper;
+        case K::RightShift:     return ImGuiKey_RightShift;
+        case K::RightControl:   return ImGuiKey_RightCtrl;
+        case K::RightAlt:       return ImGuiKey_RightAlt;
+        case K::RightSuper:     return ImGuiKey_RightSuper;
+        case K::Menu:           return ImGuiKey_Menu;
+        default:                break;
+        }
+        // clang-format on
+
+        // the remaining keys are contiguous in both enums
+        auto in = [&](K first, K last) { return key >= first and key <= last; };
+        auto at = [&](ImGuiKey base, K first) {
+            return static_cast<ImGuiKey>(base + (static_cast<int>(key) - static_cast<int>(first)));
+        };
+
+        if (in(K::Zero, K::Nine)) {
+            return at(ImGuiKey_0, K::Zero);
+        }
+        if (in(K::A, K::Z)) {
+            return at(ImGuiKey_A, K::A);
+        }
+        if (in(K::Keypad0, K::Keypad9)) {
+            return at(ImGuiKey_Keypad0, K::Keypad0);
+        }
+        if (in(K::F1, K::F12)) {
+            return at(ImGuiKey_F1, K::F1);
+        }
+#if IMGUI_VERSION_NUM >= 19000
+        if (in(K::F13, K::F24)) {
+            return at(ImGuiKey_F13, K::F13);
+        }
+#endif
+
+        return ImGuiKey_None;
+    }
+
+    /**
+     * @brief Set up the imgui context to be fed by this bridge.
+     *
+     * @param io The io of the imgui context.
+     */
+    inline void init(ImGuiIO& io) noexcept
+    {
+        assert(io.BackendPlatformName == nullptr and "Already initialized a platform backend!");
+        io.BackendPlatformName = "glfw_cpp_direct";
+    }
+
+    /**
+     * @brief Forward one event to imgui.
+     *
+     * @param io The io of the imgui context.
+     * @param event The event from window.
+     */
+    inline void process_event(ImGuiIO& io, const Event& event)
+    {
+        using namespace event;
+
+        // the mods of a modifier key event don't include the change made by the event itself
+        auto update_mods = [&](const KeyPressed& e) {
+            using K = KeyCode;
+            using M = ModifierKey;
+
+            auto mods = e.mods;
+            auto down = e.state != KeyState::Release;
+
+            // clang-format off
+            switch (e.key) {
+            case K::LeftShift:   case K::RightShift:   mods.set_to_value(down, { M::Shift });   break;
+            case K::LeftControl: case K::RightControl: mods.set_to_value(down, { M::Control }); break;
+            case K::LeftAlt:     case K::RightAlt:     mods.set_to_value(down, { M::Alt });     break;
+            case K::LeftSuper:   case K::RightSuper:   mods.set_to_value(down, { M::Super });   break;
+            default:                                                                            break;
+            }
+            // clang-format on
+
+            io.AddKeyEvent(ImGuiMod_Ctrl, mods.test(M::Control));
+            io.AddKeyEvent(ImGuiMod_Shift, mods.test(M::Shift));
+            io.AddKeyEvent(ImGuiMod_Alt, mods.test(M::Alt));
+            io.AddKeyEvent(ImGuiMod_Super, mods.test(M::Super));
+        };
+
+        event.visit(Overload{
+            [&](const WindowFocused& e) { io.AddFocusEvent(e.focused); },
+            [&](const CursorEntered& e) {
+                if (not e.entered) {
+                    io.AddMousePosEvent(-FLT_MAX, -FLT_MAX);
+                }
+            },
+            [&](const CursorMoved& e) {
+                io.AddMousePosEvent(static_cast<float>(e.x), static_cast<float>(e.y));
+            },
+            [&](const ButtonPressed& e) {
+                auto button = static_cast<int>(e.button);
+                if (button >= 0 and button < ImGuiMouseButton_COUNT) {
+                    io.AddMouseButtonEvent(button, e.state == MouseButtonState::Press);
+                }
+            },
+            [&](const Scrolled& e) {
+                io.AddMouseWheelEvent(static_cast<float>(e.dx), static_cast<float>(e.dy));
+            },
+            [&](const KeyPressed& e) {
+                update_mods(e);
+                if (auto key = to_imgui_key(e.key); key != ImGuiKey_None) {
+                    io.AddKeyEvent(key, e.state != KeyState::Release);
+                }
+            },
+            [&](const CharInput& e) { io.AddInputCharacter(e.codepoint); },
+            [&](const auto&) { /* do nothing */ },
+        });
+    }
+
+    /**
+     * @brief Forward the events of a queue to imgui.
+     *
+     * @param io The io of the imgui context.
+     * @param events The event queue from window.
+     */
+    inline void process_events(ImGuiIO& io, const EventQueue& events)
+    {
+        for (const auto& event : events) {
+            process_event(io, event);
+        }
+    }
+
+    /**
+     * @brief Update the display size, framebuffer scale, and delta time for a new imgui frame.
+     *
+     * @param io The io of the imgui context.
+     * @param window The window the imgui context belongs to.
+     *
+     * Call this before `ImGui::NewFrame()`. The values come from the window snapshot and the delta time
+     * recorded by `Window::swap_buffers()`.
+     */
+    inline void new_frame(ImGuiIO& io, const Window& window)
+    {
+        auto snapshot                     = window.snapshot();
+        const auto& [width, height]       = snapshot.dimensions;
+        const auto& [fb_width, fb_height] = snapshot.framebuffer_size;
+
+        io.DisplaySize = ImVec2{ static_cast<float>(width), static_cast<float>(height) };
+        if (width > 0 and height > 0) {
+            io.DisplayFramebufferScale = ImVec2{
+                static_cast<float>(fb_width) / static_cast<float>(width),
+                static_cast<float>(fb_height) / static_cast<float>(height),
+            };
+        }
+
+        // imgui requires a positive delta time, the first frame has none
+        auto delta   = window.delta_time();
+        io.DeltaTime = delta > 0.0 ? static_cast<float>(delta) : 1.0F / 60.0F;
+    }
+
+    /**
+     * @brief Detach the bridge from the imgui context.
+     *
+     * @param io The io of the imgui context.
+     */
+    inline void shutdown(ImGuiIO& io) noexcept
+    {
+        io.BackendPlatformName = nullptr;
+    }
+}
+
+namespace glfw_cpp::imgui
+{
+    /**
+     * @brief Check whether imgui needs another frame, for `Window::run_on_demand()`.
+     *
+     * @param events The events processed this frame.
+     * @param io The io of the imgui context.
+     *
+     * Imgui may need an extra frame to settle after input (hover state, popups opening, ...), and keeps
+     * animating while text is edited (cursor blink), an item is active, or a mouse button is held down.
+     * Must be called after `ImGui::Render()` (or `ImGui::EndFrame()`) of the frame.
+     */
+    inline bool wants_redraw(const EventQueue& events, const ImGuiIO& io = ImGui::GetIO())
+    {
+        if (not events.empty() or io.WantTextInput or ImGui::IsAnyItemActive()) {
+            return true;
+        }
+        for (auto down : io.MouseDown) {
+            if (down) {
+                return true;
+            }
+        }
+        return false;
+    }
+}
 
 #endif /* end of include guard: GLFW_CPP_IMGUI_HPP */
@@ -510,6 +510,8 @@ namespace glfw_cpp
          */
         std::vector<KeyCode> released_keys() const noexcept;
 
+        bool operator==(const KeyStateRecord&) const = default;
+
     private:
         using Element = std::uint64_t;
         using State   = std::array<Element, 2>;
@@ -612,6 +614,8 @@ namespace glfw_cpp
          */
         std::vector<MouseButton> released_buttons() const;
 
+        bool operator==(const MouseButtonStateRecord&) const = default;
+
     private:
         using State = std::uint8_t;
 
@@ -2,13 +2,23 @@
 #define GLFW_CPP_INSTANCE_HPP
 
 #include "glfw_cpp/constants.hpp"
+#include "glfw_cpp/clipboard.hpp"
 #include "glfw_cpp/error.hpp"
 #include "glfw_cpp/helper.hpp"
+#include "glfw_cpp/result.hpp"
+#include "glfw_cpp/task.hpp"
+#include "glfw_cpp/window_registry.hpp"
 
+#include <atomic>
 #include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <memory>
+#include <string>
 #include <thread>
+#include <type_traits>
 #include <utility>
 #include <variant>
 
@@ -26,6 +36,12 @@ namespace glfw_cpp
     class EventInterceptor;
     struct Event;
 
+    namespace co
+    {
+        template <typename T>
+        class FutureAwaiter;
+    }
+
     namespace gl
     {
         using Proc    = void (*)();
@@ -532,6 +548,7 @@ namespace glfw_cpp
         using Unique        = std::unique_ptr<Instance>;
 
         friend Unique init(const InitHints&);
+        friend void   set_clipboard_string(const char*);
 
         ~Instance();
         Instance& operator=(Instance&&)      = delete;
@@ -620,6 +637,8 @@ namespace glfw_cpp
          *
          * You can set the argument to `nullptr` to effectively turn off the callback. By default the value
          * for the callback is `nullptr`.
+         *
+         * With `ErrorPolicy::CallbackOnly`, this callback is the only way errors are reported.
          */
         void set_error_callback(ErrorCallback callback) noexcept { m_callback = callback; }
 
@@ -627,6 +646,10 @@ namespace glfw_cpp
          * @brief Check if any window is still open.
          *
          * @thread_safety This function can be called from any thread.
+         *
+         * A window stops counting as open once it is requested to close (by the user or with
+         * `Window::request_close()`) or destroyed, so this is a single atomic load. A close cancelled with
+         * `Window::cancel_close()` counts the window as open again.
          */
         bool has_window_opened() const noexcept;
 
@@ -638,9 +661,18 @@ namespace glfw_cpp
          * @thread_safety This function must be called from the main thread.
          *
          * @throw error::WrongThreadAccess The function is called not from the main thread.
+         * @throw error::Error With `ErrorPolicy::Deferred`, the first error collected since the last call.
          */
         void poll_events(std::optional<std::chrono::milliseconds> poll_rate = {});
 
+        /**
+         * @brief Non-throwing version of `poll_events()`.
+         *
+         * @return `ErrorCode::WrongThreadAccess` if called not from the main thread, or the first error
+         * reported by GLFW or by a queued task.
+         */
+        Result<void> poll_events_noexcept(std::optional<std::chrono::milliseconds> poll_rate = {}) noexcept;
+
         /**
          * @brief Wait for events for all windows.
          *
@@ -649,9 +681,18 @@ namespace glfw_cpp
          * @thread_safety This function must be called from the main thread.
          *
          * @throw error::WrongThreadAccess The function is called not from the main thread.
+         * @throw error::Error With `ErrorPolicy::Deferred`, the first error collected since the last call.
          */
         void wait_events(std::optional<std::chrono::milliseconds> timeout = {});
 
+        /**
+         * @brief Non-throwing version of `wait_events()`.
+         *
+         * @return `ErrorCode::WrongThreadAccess` if called not from the main thread, or the first error
+         * reported by GLFW or by a queued task.
+         */
+        Result<void> wait_events_noexcept(std::optional<std::chrono::milliseconds> timeout = {}) noexcept;
+
         /**
          * @brief Enqueue a task to be processed in the main thread.
          *
@@ -663,6 +704,92 @@ namespace glfw_cpp
          */
         void enqueue_task(std::function<void()>&& task) noexcept;
 
+        /**
+         * @brief Enqueue a task to be processed in the main thread and get its result.
+         *
+         * @param fn The task, its result (without reference) is the value of the future.
+         *
+         * @return The future result of the task.
+         *
+         * @thread_safety This function can be called from any thread.
+         *
+         * Unlike `enqueue_task()`, the main thread is woken up if it is blocked in `wait_events()`. If the
+         * task is dropped without running (a previous task of the same batch threw, or the instance is
+         * destroyed), the future gets a `std::future_error` with `std::future_errc::broken_promise`.
+         */
+        template <typename Fn>
+            requires std::invocable<std::decay_t<Fn>&>
+        task::Future<task::ResultOf<Fn>> submit_task(Fn&& fn)
+        {
+            using T = task::ResultOf<Fn>;
+
+            auto state  = task::detail::Ref<T>::make();
+            auto future = task::Future<T>{ state };
+
+            // queued as a task::Function, a small function is stored inline instead of being allocated
+            push_task(task::detail::Job<T, std::decay_t<Fn>>{ std::move(state), std::forward<Fn>(fn) });
+            wake_main_thread();
+
+            return future;
+        }
+
+        /**
+         * @brief Run a function on the main thread and wait for its result.
+         *
+         * @param fn The function.
+         *
+         * @return The result of the function.
+         *
+         * @throw Any exception thrown by the function.
+         * @throw std::future_error If the function was dropped without running, see `submit_task()`.
+         *
+         * @thread_safety This function can be called from any thread.
+         *
+         * On the main thread the function is called directly. On other threads the round-trip time is
+         * recorded, see `main_thread_latency()`.
+         */
+        template <typename Fn>
+            requires std::invocable<std::decay_t<Fn>&>
+        task::ResultOf<Fn> invoke_on_main(Fn&& fn)
+        {
+            if (std::this_thread::get_id() == m_attached_thread_id) {
+                return std::invoke(fn);
+            }
+
+            auto start  = std::chrono::steady_clock::now();
+            auto future = submit_task(std::forward<Fn>(fn));
+            future.wait();
+            record_latency(std::chrono::steady_clock::now() - start);
+
+            return future.get();
+        }
+
+        /**
+         * @brief Get the round-trip times of the `invoke_on_main()` calls since the last reset.
+         *
+         * @thread_safety This function can be called from any thread.
+         */
+        task::LatencyStats main_thread_latency() const noexcept;
+
+        /**
+         * @brief Reset the round-trip times returned by `main_thread_latency()`.
+         */
+        void reset_main_thread_latency() noexcept;
+
+        /**
+         * @brief Run a function on the main thread from a `co::Task`, see `glfw_cpp/coroutine.hpp`.
+         *
+         * @param fn The function, its result is the result of the `co_await` expression.
+         *
+         * @return An awaiter that enqueues `fn` as a task and resumes the awaiting task on the next tick of
+         * its `co::Runner`, on the render thread. An exception thrown by `fn` is rethrown there.
+         *
+         * Defined in `glfw_cpp/coroutine.hpp`.
+         */
+        template <typename Fn>
+            requires std::invocable<std::decay_t<Fn>&>
+        co::FutureAwaiter<task::ResultOf<Fn>> on_main_thread(Fn&& fn);
+
         /**
          * @brief Return the platform that was selected during initialization.
          *
@@ -675,6 +802,11 @@ namespace glfw_cpp
          */
         std::thread::id attached_thread_id() const noexcept { return m_attached_thread_id; }
 
+        /**
+         * @brief Get the cached clipboard of this instance, usable from any thread.
+         */
+        Clipboard& clipboard() noexcept { return m_clipboard; }
+
     private:
         struct CallbackHandler;
         friend CallbackHandler;
@@ -720,24 +852,62 @@ namespace glfw_cpp
          */
         void run_tasks();
 
+        /**
+         * @brief Run queued tasks, turning the exception thrown by a task into its error code.
+         */
+        Result<void> run_tasks_noexcept() noexcept;
+
         /**
          * @brief Request to delete a window.
          *
-         * @param handle The window handle.
+         * @param id The window id.
          *
          * @thread_safety This function can be called from any thread.
          */
-        void request_delete_window(GLFWwindow* handle) noexcept;
+        void request_delete_window(WindowId id) noexcept;
+
+        void push_task(task::Function&& task) noexcept;
+
+        /**
+         * @brief Wake the main thread up if it is blocked in `wait_events()`.
+         */
+        void wake_main_thread() noexcept;
+
+        void record_latency(std::chrono::nanoseconds latency) noexcept;
+
+        /**
+         * @brief Throw the first error collected by the error callback, if any (`ErrorPolicy::Deferred`).
+         *
+         * The remaining errors are discarded; their count is appended to the description.
+         */
+        void rethrow_deferred_errors();
+
+        /**
+         * @brief Non-throwing version of `rethrow_deferred_errors()`.
+         */
+        Result<void> take_deferred_errors() noexcept;
 
         std::thread::id   m_attached_thread_id = std::this_thread::get_id();
         EventInterceptor* m_event_interceptor  = nullptr;
         ErrorCallback     m_callback           = nullptr;
 
-        std::vector<GLFWwindow*>           m_windows;
-        std::vector<GLFWwindow*>           m_window_delete_queue;
-        std::vector<std::function<void()>> m_task_queue;
+        WindowRegistry              m_windows;
+        std::vector<WindowId>       m_window_delete_queue;
+        std::vector<task::Function> m_task_queue;
+        std::vector<task::Function> m_task_queue_spare;    // capacity reused by run_tasks, main thread only
 
         mutable std::mutex m_mutex;    // protects queue
+
+        // round-trip times of invoke_on_main, in ns
+        std::atomic<std::uint64_t> m_latency_count = 0;
+        std::atomic<std::uint64_t> m_latency_total = 0;
+        std::atomic<std::uint64_t> m_latency_last  = 0;
+        std::atomic<std::uint64_t> m_latency_max   = 0;
+
+        std::vector<std::pair<int, std::string>> m_deferred_errors;
+        std::mutex                               m_error_mutex;    // protects deferred errors
+
+        Clipboard m_clipboard{ *this };
     };
 
     /**
@@ -802,6 +972,9 @@ namespace glfw_cpp
      * @throw error::InvalidValue The specified extension is invalid.
      * @throw error::PlatformError If a platform-specific error occurred.
      *
+     * The lookup goes through `gl::current_extensions()`, so only the first call for each context enumerates
+     * the extensions; afterwards this is a hash lookup.
+     *
      * If you need to call this function from C (which can't handle exception) you may want to use `noexcept`
      * version of this function: `extension_supported_noexcept()`.
      */
@@ -813,8 +986,9 @@ namespace glfw_cpp
      * @param extension The name of the extensio in ASCII.
      * @return True if extension is available or false otherwise.
      *
-     * This function is a wrapper of `glfwExtensionSupported` function. The error will be logged but this
-     * function won't throw to preserve the behavior from the underlying function. The possible errors are:
+     * The lookup goes through `gl::current_extensions()` like `extension_supported()`, so both give the same
+     * answers. The error will be logged but this function won't throw to preserve the behavior of
+     * `glfwExtensionSupported`. The possible errors are:
      * - `ErrorCode::NotInitialized`,
      * - `ErrorCode::NoCurrentContext`,
      * - `ErrorCode::InvalidValue`, and
@@ -839,6 +1013,18 @@ namespace glfw_cpp
      */
     Instance::Unique init(const InitHints& hints);
 
+    /**
+     * @struct ContextSwitchStats
+     * @brief Per-thread counters of `make_current()` and `get_current()` calls.
+     */
+    struct ContextSwitchStats
+    {
+        std::size_t switches       = 0;    // calls that reached `glfwMakeContextCurrent`
+        std::size_t avoided        = 0;    // calls skipped because the context was already current
+        std::size_t queries        = 0;    // calls that reached `glfwGetCurrentContext`
+        std::size_t cached_queries = 0;    // calls answered from the cache
+    };
+
     /**
      * @brief Make the OpenGL or OpenGL ES context of the specified window current on calling thread.
      *
@@ -847,27 +1033,70 @@ namespace glfw_cpp
      * @throw error::NotInitialized if GLFW is not initialized.
      * @throw error::NoWindowContext if the window doesn't have OpenGL or OpenGL ES context.
      * @throw error::PlatformError if a platform-specific error occurred.
+     *
+     * The current context of each thread is cached, so making the already current context current again
+     * does not call `glfwMakeContextCurrent`. If you call `glfwMakeContextCurrent` directly, the cache is out
+     * of sync; call `invalidate_current_cache()` afterwards. The caches of every thread are dropped when a
+     * window is destroyed, since its handle may be reused by a later window.
      */
     void make_current(GLFWwindow* window);
 
+    /**
+     * @brief Non-throwing version of `make_current()`.
+     *
+     * @return The error reported by GLFW, if any.
+     */
+    Result<void> make_current_noexcept(GLFWwindow* window) noexcept;
+
     /**
      * @brief Get window handle whose context is current.
      *
      * @throw error::NotInitialized if GLFW is not initialized.
+     *
+     * Only the first call on each thread (or the first after the cache is invalidated) queries GLFW.
      */
     GLFWwindow* get_current();
 
+    /**
+     * @brief Non-throwing version of `get_current()`.
+     *
+     * @return The window handle whose context is current, or the error reported by GLFW.
+     */
+    Result<GLFWwindow*> get_current_noexcept() noexcept;
+
+    /**
+     * @brief Forget the cached current context of the calling thread.
+     *
+     * The next `make_current()` or `get_current()` will go through GLFW.
+     */
+    void invalidate_current_cache() noexcept;
+
+    /**
+     * @brief Get the context switch counters of the calling thread.
+     */
+    ContextSwitchStats context_switch_stats() noexcept;
+
+    /**
+     * @brief Reset the context switch counters of the calling thread.
+     */
+    void reset_context_switch_stats() noexcept;
+
     /**
      * @brief Set the clipboard string.
      *
      * @param string The string to set (must be null-terminated).
+     *
+     * Must be called on the main thread, see `Instance::clipboard()` for other threads.
      */
     void set_clipboard_string(const char* string);
 
     /**
      * @brief Get the clipboard string.
      *
-     * @return The clipboard string.
+     * @return The clipboard string, valid until the next clipboard call.
+     *
+     * Must be called on the main thread. This always goes through GLFW and may block on the selection owner;
+     * `Instance::clipboard()` caches the text and can be read from any thread.
      */
     std::string_view get_clipboard_string();
 
@@ -0,0 +1,134 @@
+#ifndef GLFW_CPP_PROC_TABLE_HPP
+#define GLFW_CPP_PROC_TABLE_HPP
+
+#include "glfw_cpp/instance.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace glfw_cpp::gl
+{
+    /**
+     * @struct ContextSignature
+     * @brief Identifies the implementation behind an OpenGL or OpenGL ES context.
+     *
+     * Contexts with the same signature are served by the same driver, so the procedure addresses resolved on
+     * one of them are valid on the others.
+     */
+    struct ContextSignature
+    {
+        std::string vendor;              // `GL_VENDOR`
+        std::string renderer;            // `GL_RENDERER`
+        std::string version;             // `GL_VERSION`
+        int         profile_mask = 0;    // `GL_CONTEXT_PROFILE_MASK`, zero before OpenGL 3.2 and on ES
+
+        bool operator==(const ContextSignature&) const = default;
+    };
+
+    /**
+     * @class ProcTable
+     * @brief Contiguous table of procedure addresses resolved from a list of names.
+     *
+     * The address of `names[i]` is at index `i`; names that can't be resolved have a null address.
+     */
+    class ProcTable
+    {
+    public:
+        /**
+         * @brief Resolve every name in one pass using the current context.
+         *
+         * @param signature The signature of the current context.
+         * @param names The names to resolve.
+         * @param loader The function resolving the names, or `nullptr` for `glfwGetProcAddress`.
+         *
+         * @throw error::NoCurrentContext If no context is current on the calling thread.
+         *
+         * Errors of `glfwGetProcAddress` are checked once after the whole list is resolved. Prefer
+         * `load_proc_table()` which reuses the tables of contexts with the same signature.
+         */
+        ProcTable(ContextSignature signature, std::span<const char* const> names, GetProc* loader = nullptr);
+
+        Proc operator[](std::size_t index) const noexcept { return m_procs[index]; }
+
+        /**
+         * @brief Get the address at index cast to the function pointer type `Fn`.
+         */
+        template <typename Fn>
+        Fn get(std::size_t index) const noexcept
+        {
+            return reinterpret_cast<Fn>(m_procs[index]);
+        }
+
+        std::span<const Proc>        procs() const noexcept { return m_procs; }
+        std::span<const char* const> names() const noexcept { return m_names; }
+
+        const ContextSignature& signature() const noexcept { return m_signature; }
+
+        std::size_t size() const noexcept { return m_procs.size(); }
+
+        /**
+         * @brief Get the number of names that couldn't be resolved.
+         */
+        std::size_t missing() const noexcept { return m_missing; }
+
+    private:
+        ContextSignature             m_signature;
+        std::span<const char* const> m_names;
+        std::vector<Proc>            m_procs;
+        std::size_t                  m_missing = 0;
+    };
+
+    /**
+     * @brief Query the signature of the current context.
+     *
+     * @throw error::NoCurrentContext If no context is current on the calling thread.
+     */
+    ContextSignature current_context_signature();
+
+    /**
+     * @brief Get the procedure table of `names` for the current context.
+     *
+     * @param names The names to resolve; the list must outlive the table (e.g. a static array).
+     * @return The resolved table, shared with every context that has the same signature.
+     *
+     * @throw error::NoCurrentContext If no context is current on the calling thread.
+     *
+     * The tables are cached by list (its address and size) and by context signature, so only the first
+     * context of each kind resolves the names; the other contexts only pay for the signature query. The
+     * cache is cleared when GLFW is terminated since the addresses may belong to an unloaded library.
+     *
+     * @thread_safety This function can be called from any thread with a current context.
+     */
+    std::shared_ptr<const ProcTable> load_proc_table(std::span<const char* const> names);
+
+    /**
+     * @brief Get the procedure table of `names` for a context with the given signature.
+     *
+     * @param names The names to resolve; the list must outlive the table (e.g. a static array).
+     * @param signature The signature of the context the names are resolved for.
+     * @param loader The function resolving the names, or `nullptr` for `glfwGetProcAddress`.
+     * @return The resolved table, shared with every context that has the same signature.
+     *
+     * For contexts whose signature is already known or whose procedures are resolved by another loader; the
+     * cache is shared with the other overload.
+     *
+     * @thread_safety This function can be called from any thread; `loader` is called on the calling thread.
+     */
+    std::shared_ptr<const ProcTable> load_proc_table(
+        std::span<const char* const> names,
+        const ContextSignature&      signature,
+        GetProc*                     loader
+    );
+
+    /**
+     * @brief Drop every cached procedure table.
+     *
+     * Tables already handed out are not affected.
+     */
+    void clear_proc_table_cache() noexcept;
+}
+
+#endif /* end of include guard: GLFW_CPP_PROC_TABLE_HPP */
@@ -0,0 +1,184 @@
+#ifndef GLFW_CPP_RENDER_SCHEDULER_HPP
+#define GLFW_CPP_RENDER_SCHEDULER_HPP
+
+#include "glfw_cpp/window.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace glfw_cpp
+{
+    /**
+     * @class RenderScheduler
+     * @brief Multiplexes many windows onto a fixed pool of render threads.
+     *
+     * Instead of dedicating a thread to each window, every window is a job that renders a single frame at a
+     * time. Each render thread owns a deque of ready jobs; it takes jobs from the front of its own deque and
+     * requeues them at the back so its windows are served round-robin, and when it runs dry it steals from
+     * the back of the other threads' deques. The window context migrates with the job: it is made current on
+     * the thread that acquires the job and released (made non-current) once the frame is done, so the next
+     * frame may be rendered by any thread.
+     *
+     * A window can be given a target rate, in which case the job is parked until its next deadline instead
+     * of being requeued right away. Frames that start later than one full period past their deadline are
+     * counted as missed.
+     *
+     * Since a swap that waits for vsync would block a whole render thread, vsync is disabled on every window
+     * added to the scheduler; use target rates to pace the windows instead.
+     *
+     * Windows without a context (`Api::NoApi`, e.g. Vulkan windows) are scheduled the same way, minus the
+     * context migration and the buffer swap: the render function presents the frame itself.
+     *
+     * A window whose `should_close()` returns true is retired from the scheduler after its current frame.
+     * The window itself is not destroyed; it must outlive the scheduler (or at least its retirement) and
+     * must not be moved while it is scheduled.
+     *
+     * ```cpp
+     * auto scheduler = glfw_cpp::RenderScheduler{ 4 };
+     * for (auto& window : windows) {
+     *     scheduler.add(window, render, 60.0);
+     * }
+     *
+     * while (scheduler.active() > 0) {
+     *     glfw->poll_events();
+     * }
+     * ```
+     */
+    class RenderScheduler
+    {
+    public:
+        using Clock  = std::chrono::steady_clock;
+        using Sig    = void(Window& window, const EventQueue& events);
+        using Render = std::function<Sig>;
+
+        /**
+         * @struct Stats
+         * @brief Counters of the scheduler.
+         */
+        struct Stats
+        {
+            std::size_t frames = 0;    // frames rendered
+            std::size_t steals = 0;    // jobs taken from another thread's deque
+            std::size_t missed = 0;    // frames started more than a period past their deadline
+        };
+
+        /**
+         * @brief Start the render threads.
+         *
+         * @param thread_count Number of render threads; zero means `std::thread::hardware_concurrency()`.
+         */
+        explicit RenderScheduler(std::size_t thread_count = 0);
+
+        /**
+         * @brief Stop and join the render threads.
+         *
+         * Frames in progress are completed; the remaining jobs are discarded.
+         */
+        ~RenderScheduler();
+
+        RenderScheduler(RenderScheduler&&)            = delete;
+        RenderScheduler& operator=(RenderScheduler&&) = delete;
+
+        /**
+         * @brief Schedule a window.
+         *
+         * @param window The window to render.
+         * @param render The function called for each frame between swapping events and swapping buffers.
+         * @param target_rate The rate at which the window should be rendered in frames per second, or
+         * `std::nullopt` to render as fast as possible.
+         *
+         * @throw error::PlatformError If platform-specific error occurs.
+         *
+         * The window context must not be current on any thread. This function can be called from any thread.
+         * The queues of the render threads are grown here, so scheduling never allocates afterwards.
+         */
+        void add(Window& window, Render render, std::optional<double> target_rate = std::nullopt);
+
+        /**
+         * @brief Get the number of windows that have not been retired yet.
+         *
+         * @throw Any exception thrown by a render function; the window that threw is retired.
+         */
+        std::size_t active() const;
+
+        /**
+         * @brief Block until every window has been retired.
+         *
+         * @throw Any exception thrown by a render function; the window that threw is retired.
+         *
+         * Don't call this on the main thread while the windows still need events to be polled.
+         */
+        void wait() const;
+
+        /**
+         * @brief Get the scheduler counters.
+         */
+        Stats stats() const noexcept;
+
+        /**
+         * @brief Get the number of render threads.
+         */
+        std::size_t thread_count() const noexcept { return m_workers.size(); }
+
+    private:
+        struct Job
+        {
+            Window*                        window;
+            Render                         render;
+            std::optional<Clock::duration> period;
+            Clock::time_point              deadline;
+        };
+
+        /**
+         * @brief Render thread state, holding its ready jobs in a ring sized by `add()` for every job.
+         */
+        struct Worker
+        {
+            std::vector<Job*> ring;
+            std::size_t       head  = 0;
+            std::size_t       count = 0;
+            std::mutex        mutex;    // protects the ring
+
+            void reserve(std::size_t capacity);
+            void push_back(Job* job) noexcept;
+            Job* pop_front() noexcept;
+            Job* pop_back() noexcept;
+        };
+
+        void work(std::stop_token stop, std::size_t index) noexcept;
+        void run_frame(Job& job, std::size_t index) noexcept;
+        void retire(Job& job, std::exception_ptr exception) noexcept;
+        void park(Job& job) noexcept;
+        void push(std::size_t index, Job& job) noexcept;
+        void release_due(std::size_t index) noexcept;
+
+        Job* pop(std::size_t index) noexcept;
+        Job* steal(std::size_t index) noexcept;
+
+        std::vector<std::unique_ptr<Worker>> m_workers;
+        std::vector<std::unique_ptr<Job>>    m_jobs;
+        std::vector<Job*>                    m_parked;    // min-heap on deadline, reserved for every job
+        mutable std::exception_ptr           m_exception;
+
+        mutable std::mutex                  m_mutex;    // protects jobs, parked jobs, and exception
+        mutable std::condition_variable_any m_cv;
+
+        std::atomic<std::size_t> m_ready  = 0;    // jobs in the worker deques
+        std::atomic<std::size_t> m_frames = 0;
+        std::atomic<std::size_t> m_steals = 0;
+        std::atomic<std::size_t> m_missed = 0;
+
+        std::vector<std::jthread> m_threads;    // last member, so the threads are joined first
+    };
+}
+
+#endif /* end of include guard: GLFW_CPP_RENDER_SCHEDULER_HPP */
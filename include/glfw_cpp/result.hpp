@@ -0,0 +1,137 @@
+#ifndef GLFW_CPP_RESULT_HPP
+#define GLFW_CPP_RESULT_HPP
+
+#include "glfw_cpp/error.hpp"
+
+#include <cassert>
+#include <concepts>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+namespace glfw_cpp
+{
+    /**
+     * @struct Unexpected
+     * @brief Tag to construct a `Result` holding an error, analogous to `std::unexpected`.
+     */
+    struct Unexpected
+    {
+        ErrorCode code;
+    };
+
+    /**
+     * @class Result
+     * @brief Either a value or an `ErrorCode`; the return type of the `_noexcept` functions.
+     *
+     * This is a minimal stand-in for C++23 `std::expected<T, ErrorCode>`. None of its member functions throw:
+     * accessing the value of a `Result` that holds an error (or the reverse) is a precondition violation
+     * checked by an assertion.
+     *
+     * ```cpp
+     * if (auto delta = window.swap_buffers_noexcept(); delta) {
+     *     update(*delta);
+     * } else {
+     *     log(to_string(delta.error()));
+     * }
+     * ```
+     */
+    template <typename T>
+    class [[nodiscard]] Result
+    {
+    public:
+        using Value = T;
+
+        template <typename U = T>
+            requires std::constructible_from<T, U&&>
+                 and (not std::same_as<std::remove_cvref_t<U>, Unexpected>)
+        constexpr Result(U&& value) noexcept(std::is_nothrow_constructible_v<T, U&&>)
+            : m_storage{ std::in_place_index<0>, std::forward<U>(value) }
+        {
+        }
+
+        constexpr Result(Unexpected error) noexcept
+            : m_storage{ std::in_place_index<1>, error.code }
+        {
+            assert(error.code != ErrorCode::NoError);
+        }
+
+        constexpr bool     has_value() const noexcept { return m_storage.index() == 0; }
+        constexpr explicit operator bool() const noexcept { return has_value(); }
+
+        constexpr T& value() & noexcept
+        {
+            assert(has_value());
+            return *std::get_if<0>(&m_storage);
+        }
+
+        constexpr const T& value() const& noexcept
+        {
+            assert(has_value());
+            return *std::get_if<0>(&m_storage);
+        }
+
+        constexpr T&& value() && noexcept
+        {
+            assert(has_value());
+            return std::move(*std::get_if<0>(&m_storage));
+        }
+
+        constexpr ErrorCode error() const noexcept
+        {
+            assert(not has_value());
+            return *std::get_if<1>(&m_storage);
+        }
+
+        template <typename U>
+        constexpr T value_or(U&& fallback) const&
+        {
+            return has_value() ? value() : static_cast<T>(std::forward<U>(fallback));
+        }
+
+        constexpr T&       operator*() & noexcept { return value(); }
+        constexpr const T& operator*() const& noexcept { return value(); }
+        constexpr T&&      operator*() && noexcept { return std::move(*this).value(); }
+
+        constexpr T*       operator->() noexcept { return &value(); }
+        constexpr const T* operator->() const noexcept { return &value(); }
+
+    private:
+        std::variant<T, ErrorCode> m_storage;
+    };
+
+    /**
+     * @class Result<void>
+     * @brief Specialization of `Result` for functions that only report success or an `ErrorCode`.
+     */
+    template <>
+    class [[nodiscard]] Result<void>
+    {
+    public:
+        using Value = void;
+
+        constexpr Result() noexcept = default;
+
+        constexpr Result(Unexpected error) noexcept
+            : m_error{ error.code }
+        {
+            assert(error.code != ErrorCode::NoError);
+        }
+
+        constexpr bool     has_value() const noexcept { return m_error == ErrorCode::NoError; }
+        constexpr explicit operator bool() const noexcept { return has_value(); }
+
+        constexpr void value() const noexcept { assert(has_value()); }
+
+        constexpr ErrorCode error() const noexcept
+        {
+            assert(not has_value());
+            return m_error;
+        }
+
+    private:
+        ErrorCode m_error = ErrorCode::NoError;
+    };
+}
+
+#endif /* end of include guard: GLFW_CPP_RESULT_HPP */
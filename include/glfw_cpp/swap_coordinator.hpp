@@ -0,0 +1,147 @@
+#ifndef GLFW_CPP_SWAP_COORDINATOR_HPP
+#define GLFW_CPP_SWAP_COORDINATOR_HPP
+
+#include "glfw_cpp/window.hpp"
+
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+namespace glfw_cpp
+{
+    /**
+     * @class SwapCoordinator
+     * @brief Paces buffer swaps of multiple windows rendered from a single thread.
+     *
+     * When several windows with vsync enabled are rendered from one thread, each `swap_buffers()` blocks for
+     * a full display refresh and N windows end up running at refresh rate / N. The coordinator avoids this
+     * by enabling vsync (swap interval 1) only on the window that swaps last in a frame and disabling it
+     * (swap interval 0) on the rest, so exactly one swap per frame waits for the vertical retrace and every
+     * window presents at the display rate.
+     *
+     * Each window can optionally be given a target rate lower than the display rate; the window is then only
+     * rendered in frames where its deadline has passed.
+     *
+     * The coordinator stores pointers to the windows, so registered windows must not be moved or destroyed
+     * while registered. All the windows must be rendered from the same thread.
+     *
+     * ```cpp
+     * auto coordinator = glfw_cpp::SwapCoordinator{};
+     * coordinator.add(window_1);
+     * coordinator.add(window_2, 30.0);    // render at most at 30 fps
+     *
+     * while (coordinator.frame([&](glfw_cpp::Window& window, const glfw_cpp::EventQueue& events) {
+     *     render(window, events);
+     * })) {
+     *     glfw->poll_events();
+     * }
+     * ```
+     */
+    class SwapCoordinator
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        /**
+         * @brief Register a window.
+         *
+         * @param window The window to be coordinated.
+         * @param target_rate The rate at which the window should be rendered in frames per second, or
+         * `std::nullopt` to render at the display rate.
+         *
+         * Registering an already registered window only updates its target rate.
+         */
+        void add(Window& window, std::optional<double> target_rate = std::nullopt);
+
+        /**
+         * @brief Unregister a window.
+         *
+         * @param window The window to be removed.
+         *
+         * The window keeps the swap interval it was last given by the coordinator.
+         */
+        void remove(const Window& window) noexcept;
+
+        /**
+         * @brief Change the target rate of a registered window.
+         *
+         * @param window The window.
+         * @param target_rate The rate at which the window should be rendered in frames per second, or
+         * `std::nullopt` to render at the display rate.
+         */
+        void set_target_rate(const Window& window, std::optional<double> target_rate) noexcept;
+
+        /**
+         * @brief Get the number of registered windows.
+         */
+        std::size_t size() const noexcept { return m_entries.size(); }
+
+        /**
+         * @brief Render one frame of every window that is due.
+         *
+         * @param func The function to be called for each window between swapping events and swapping buffers.
+         * @return The number of windows rendered; zero if every registered window should close.
+         *
+         * @throw error::NoWindowContext If a window doesn't have a context (e.g. Api::NoApi).
+         * @throw error::PlatformError If platform-specific error occurs.
+         *
+         * For each window due this frame, the window context is made current, its events are swapped, `func`
+         * is called, and its buffers are swapped. The previously current context is restored at the end. If
+         * no window is due yet, this function sleeps until the nearest deadline.
+         */
+        std::size_t frame(std::invocable<Window&, const EventQueue&> auto&& func)
+        {
+            const auto& due = schedule();
+            if (due.empty()) {
+                return 0;
+            }
+
+            auto prev = glfw_cpp::get_current();
+
+            for (auto i = 0u; i < due.size(); ++i) {
+                auto& window = *due[i];
+                auto  pacer  = i + 1 == due.size();    // only the last swap of the frame waits for vsync
+
+                glfw_cpp::make_current(window.handle());
+                if (window.is_vsync() != pacer) {
+                    window.set_vsync(pacer);
+                }
+
+                const auto& events = window.swap_events();
+                func(window, events);
+                window.swap_buffers();
+            }
+
+            glfw_cpp::make_current(prev);
+            return due.size();
+        }
+
+        /**
+         * @brief Collect the windows due this frame, waiting for the nearest deadline if none is due.
+         *
+         * @return The windows due, empty if every registered window should close. The windows with a target
+         * rate come first in registration order, the windows rendered at the display rate last; `frame()`
+         * gives vsync to the last one. The reference is valid until the next call.
+         *
+         * Calling this advances the deadlines of the returned windows, use it instead of `frame()` only to
+         * drive a custom render loop.
+         */
+        const std::vector<Window*>& schedule();
+
+    private:
+        struct Entry
+        {
+            Window*                        window;
+            std::optional<Clock::duration> period;
+            Clock::time_point              deadline;
+        };
+
+        std::vector<Entry>   m_entries;
+        std::vector<Window*> m_due;
+        std::vector<Window*> m_display_rate;    // due display-rate windows, appended to m_due
+    };
+}
+
+#endif /* end of include guard: GLFW_CPP_SWAP_COORDINATOR_HPP */
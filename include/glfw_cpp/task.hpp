@@ -0,0 +1,441 @@
+#ifndef GLFW_CPP_TASK_HPP
+#define GLFW_CPP_TASK_HPP
+
+#include <atomic>
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+/**
+ * @brief Results of the tasks run on the main thread, see `Instance::submit_task()`.
+ */
+namespace glfw_cpp::task
+{
+    /**
+     * @brief Result type of a task function, without reference (the value is copied out of the main thread).
+     */
+    template <typename Fn>
+    using ResultOf = std::remove_cvref_t<std::invoke_result_t<std::decay_t<Fn>&>>;
+
+    namespace detail
+    {
+        template <typename T>
+        using Stored = std::conditional_t<std::is_void_v<T>, std::monostate, T>;
+
+        /**
+         * @brief Shared state between a `Future` and the task producing its value.
+         *
+         * The states are recycled by `Pool`, so a task in steady state does not allocate its state.
+         */
+        template <typename T>
+        struct State
+        {
+            std::atomic<std::uint32_t> refs  = 0;
+            std::atomic<bool>          ready = false;
+            std::optional<Stored<T>>   value;
+            std::exception_ptr         exception;
+            State*                     next = nullptr;    // free list of the pool
+
+            template <typename Fn>
+            void run(Fn& fn) noexcept
+            {
+                try {
+                    if constexpr (std::is_void_v<T>) {
+                        fn();
+                        value.emplace();
+                    } else {
+                        value.emplace(fn());
+                    }
+                } catch (...) {
+                    exception = std::current_exception();
+                }
+
+                publish();
+            }
+
+            /**
+             * @brief Complete the state with a broken promise error, for a task destroyed before it ran.
+             */
+            void abandon() noexcept
+            {
+                try {
+                    throw std::future_error{ std::future_errc::broken_promise };
+                } catch (...) {
+                    exception = std::current_exception();
+                }
+
+                publish();
+            }
+
+            void publish() noexcept
+            {
+                ready.store(true, std::memory_order::release);
+                ready.notify_all();
+            }
+        };
+
+        /**
+         * @brief Free list of the states of one result type, shared by every thread.
+         */
+        template <typename T>
+        class Pool
+        {
+        public:
+            static constexpr std::size_t s_max_pooled = 64;
+
+            ~Pool()
+            {
+                while (m_free != nullptr) {
+                    delete std::exchange(m_free, m_free->next);
+                }
+            }
+
+            static Pool& get() noexcept
+            {
+                static auto pool = Pool{};
+                return pool;
+            }
+
+            State<T>* acquire()
+            {
+                {
+                    auto lock = std::scoped_lock{ m_mutex };
+                    if (m_free != nullptr) {
+                        --m_size;
+                        return std::exchange(m_free, m_free->next);
+                    }
+                }
+                return new State<T>{};
+            }
+
+            void release(State<T>* state) noexcept
+            {
+                state->ready.store(false, std::memory_order::relaxed);
+                state->value.reset();
+                state->exception = nullptr;
+
+                {
+                    auto lock = std::scoped_lock{ m_mutex };
+                    if (m_size < s_max_pooled) {
+                        state->next = std::exchange(m_free, state);
+                        ++m_size;
+                        return;
+                    }
+                }
+                delete state;
+            }
+
+        private:
+            Pool() = default;
+
+            std::mutex  m_mutex;
+            State<T>*   m_free = nullptr;
+            std::size_t m_size = 0;
+        };
+
+        /**
+         * @brief Intrusive reference to a pooled state.
+         */
+        template <typename T>
+        class Ref
+        {
+        public:
+            Ref() = default;
+
+            static Ref make()
+            {
+                auto ref    = Ref{};
+                ref.m_state = Pool<T>::get().acquire();
+                ref.m_state->refs.store(1, std::memory_order::relaxed);
+                return ref;
+            }
+
+            Ref(const Ref& other) noexcept
+                : m_state{ other.m_state }
+            {
+                if (m_state != nullptr) {
+                    m_state->refs.fetch_add(1, std::memory_order::relaxed);
+                }
+            }
+
+            Ref(Ref&& other) noexcept
+                : m_state{ std::exchange(other.m_state, nullptr) }
+            {
+            }
+
+            Ref& operator=(Ref other) noexcept
+            {
+                std::swap(m_state, other.m_state);
+                return *this;
+            }
+
+            ~Ref()
+            {
+                if (m_state != nullptr and m_state->refs.fetch_sub(1, std::memory_order::acq_rel) == 1) {
+                    Pool<T>::get().release(m_state);
+                }
+            }
+
+            State<T>* operator->() const noexcept { return m_state; }
+            explicit operator bool() const noexcept { return m_state != nullptr; }
+
+        private:
+            State<T>* m_state = nullptr;
+        };
+
+        /**
+         * @brief Queued form of a submitted task, completes its state with the result of the function.
+         *
+         * Like a `std::promise`, a job destroyed before it ran (dropped with the rest of its batch after a
+         * task threw, or still queued when the instance is destroyed) breaks the promise: the future is made
+         * ready with a `std::future_error` of code `std::future_errc::broken_promise`.
+         */
+        template <typename T, typename Fn>
+        class Job
+        {
+        public:
+            template <typename F>
+            Job(Ref<T> state, F&& fn)
+                : m_state{ std::move(state) }
+                , m_fn{ std::forward<F>(fn) }
+            {
+            }
+
+            Job(Job&&)                 = default;
+            Job& operator=(Job&&)      = delete;
+            Job(const Job&)            = delete;
+            Job& operator=(const Job&) = delete;
+
+            ~Job()
+            {
+                // moved-from jobs have no state, the state of a job that ran is already ready
+                if (m_state and not m_state->ready.load(std::memory_order::relaxed)) {
+                    m_state->abandon();
+                }
+            }
+
+            void operator()() { m_state->run(m_fn); }
+
+        private:
+            Ref<T> m_state;
+            Fn     m_fn;
+        };
+    }
+
+    /**
+     * @class Function
+     * @brief Move-only `void()` callable that stores small callables inline, the queued form of a task.
+     *
+     * `std::function` allocates most callables (libstdc++ only stores trivially copyable ones of up to two
+     * pointers inline) and requires them to be copyable. Here any nothrow movable callable of up to
+     * `s_inline_size` bytes is stored in the object itself, larger ones are allocated.
+     */
+    class Function
+    {
+    public:
+        static constexpr std::size_t s_inline_size = 48;
+
+        Function() = default;
+
+        template <typename Fn>
+            requires(not std::same_as<std::decay_t<Fn>, Function>) and std::invocable<std::decay_t<Fn>&>
+        Function(Fn&& fn)
+        {
+            using F = std::decay_t<Fn>;
+
+            if constexpr (s_fits_inline<F>) {
+                ::new (static_cast<void*>(m_storage)) F(std::forward<Fn>(fn));
+                m_ops = &s_inline_ops<F>;
+            } else {
+                ::new (static_cast<void*>(m_storage)) F*(new F(std::forward<Fn>(fn)));
+                m_ops = &s_heap_ops<F>;
+            }
+        }
+
+        Function(Function&& other) noexcept { take(other); }
+
+        Function& operator=(Function&& other) noexcept
+        {
+            if (this != &other) {
+                reset();
+                take(other);
+            }
+            return *this;
+        }
+
+        Function(const Function&)            = delete;
+        Function& operator=(const Function&) = delete;
+
+        ~Function() { reset(); }
+
+        void operator()() { m_ops->call(m_storage); }
+
+        explicit operator bool() const noexcept { return m_ops != nullptr; }
+
+        /**
+         * @brief Check whether the callable is stored inline (no allocation was made for it).
+         */
+        bool is_inline() const noexcept { return m_ops != nullptr and m_ops->is_inline; }
+
+    private:
+        struct Ops
+        {
+            void (*call)(void*);
+            void (*move)(void* from, void* to) noexcept;    // leaves `from` destroyed
+            void (*destroy)(void*) noexcept;
+            bool is_inline;
+        };
+
+        template <typename F>
+        static constexpr bool s_fits_inline = sizeof(F) <= s_inline_size
+                                          and alignof(F) <= alignof(std::max_align_t)
+                                          and std::is_nothrow_move_constructible_v<F>;
+
+        template <typename F>
+        static constexpr Ops s_inline_ops = {
+            .call = [](void* self) { std::invoke(*std::launder(static_cast<F*>(self))); },
+            .move =
+                [](void* from, void* to) noexcept {
+                    auto* source = std::launder(static_cast<F*>(from));
+                    ::new (to) F(std::move(*source));
+                    source->~F();
+                },
+            .destroy   = [](void* self) noexcept { std::launder(static_cast<F*>(self))->~F(); },
+            .is_inline = true,
+        };
+
+        template <typename F>
+        static constexpr Ops s_heap_ops = {
+            .call = [](void* self) { std::invoke(**std::launder(static_cast<F**>(self))); },
+            .move =
+                [](void* from, void* to) noexcept {
+                    ::new (to) F*(*std::launder(static_cast<F**>(from)));    // the pointer is trivial
+                },
+            .destroy   = [](void* self) noexcept { delete *std::launder(static_cast<F**>(self)); },
+            .is_inline = false,
+        };
+
+        void take(Function& other) noexcept
+        {
+            if (other.m_ops != nullptr) {
+                other.m_ops->move(other.m_storage, m_storage);
+                m_ops = std::exchange(other.m_ops, nullptr);
+            }
+        }
+
+        void reset() noexcept
+        {
+            if (m_ops != nullptr) {
+                std::exchange(m_ops, nullptr)->destroy(m_storage);
+            }
+        }
+
+        alignas(std::max_align_t) std::byte m_storage[s_inline_size];
+        const Ops* m_ops = nullptr;
+    };
+
+    /**
+     * @class Future
+     * @brief Result of a task submitted to the main thread with `Instance::submit_task()`.
+     *
+     * Like `std::future`, but the shared state is taken from a per-type pool instead of being allocated for
+     * every task, and waiting is done on an atomic flag. In a `co::Task` (see `glfw_cpp/coroutine.hpp`) the
+     * future can be awaited.
+     *
+     * @tparam T The result type of the task.
+     */
+    template <typename T>
+    class [[nodiscard]] Future
+    {
+    public:
+        Future() = default;
+
+        explicit Future(detail::Ref<T> state) noexcept
+            : m_state{ std::move(state) }
+        {
+        }
+
+        Future(Future&&) noexcept            = default;
+        Future& operator=(Future&&) noexcept = default;
+        Future(const Future&)                = delete;
+        Future& operator=(const Future&)     = delete;
+
+        /**
+         * @brief Check whether the future refers to a task (false once `get()` was called).
+         */
+        bool valid() const noexcept { return static_cast<bool>(m_state); }
+
+        /**
+         * @brief Check whether the task has completed, without blocking.
+         */
+        bool ready() const noexcept { return m_state->ready.load(std::memory_order::acquire); }
+
+        /**
+         * @brief Block until the task has completed.
+         *
+         * Must not be called on the main thread, the task would never run.
+         */
+        void wait() const noexcept { m_state->ready.wait(false, std::memory_order::acquire); }
+
+        /**
+         * @brief Wait for the task and get its result.
+         *
+         * @throw Any exception thrown by the task.
+         * @throw std::future_error With `std::future_errc::broken_promise` if the task was dropped unrun.
+         *
+         * The future is invalid afterwards.
+         */
+        T get()
+        {
+            wait();
+
+            auto state = std::exchange(m_state, {});
+            if (state->exception) {
+                std::rethrow_exception(state->exception);
+            }
+            if constexpr (not std::is_void_v<T>) {
+                return std::move(*state->value);
+            }
+        }
+
+    private:
+        detail::Ref<T> m_state;
+    };
+
+    /**
+     * @brief Make a future that is already ready with the given value.
+     */
+    template <typename T>
+    Future<std::decay_t<T>> make_ready(T&& value)
+    {
+        auto state = detail::Ref<std::decay_t<T>>::make();
+        auto fn    = [&]() -> std::decay_t<T> { return std::forward<T>(value); };
+        state->run(fn);
+
+        return Future<std::decay_t<T>>{ std::move(state) };
+    }
+
+    /**
+     * @struct LatencyStats
+     * @brief Round-trip times of the `Instance::invoke_on_main()` calls, from submission to result.
+     */
+    struct LatencyStats
+    {
+        std::size_t              count = 0;
+        std::chrono::nanoseconds last  = {};
+        std::chrono::nanoseconds max   = {};
+        std::chrono::nanoseconds mean  = {};
+    };
+}
+
+#endif /* end of include guard: GLFW_CPP_TASK_HPP */
@@ -0,0 +1,104 @@
+#ifndef GLFW_CPP_TRACE_HPP
+#define GLFW_CPP_TRACE_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+
+/**
+ * @brief Timeline instrumentation dumped in the Chrome trace event format (chrome://tracing, Perfetto).
+ *
+ * The instrumentation is enabled with the CMake option `GLFW_CPP_ENABLE_TRACE`. The library records spans
+ * around polling, event dispatch, interceptor calls, task execution, window destruction, `swap_events`, and
+ * `swap_buffers`; applications can add their own with `Span`. Each thread records into its own buffer of
+ * `GLFW_CPP_TRACE_CAPACITY` spans (65536 by default) without any lock, spans are dropped once it is full.
+ *
+ * When disabled, `Span` is an empty type and `dump()` writes an empty trace.
+ *
+ * ```cpp
+ * {
+ *     auto span = glfw_cpp::trace::Span{ "draw" };
+ *     draw();
+ * }
+ * // ...
+ * auto file = std::ofstream{ "trace.json" };
+ * glfw_cpp::trace::dump(file);
+ * ```
+ */
+namespace glfw_cpp::trace
+{
+#if defined(GLFW_CPP_ENABLE_TRACE)
+    inline constexpr bool enabled = true;
+#else
+    inline constexpr bool enabled = false;
+#endif
+
+    namespace detail
+    {
+        inline std::uint64_t now() noexcept
+        {
+            auto time = std::chrono::steady_clock::now().time_since_epoch();
+            return static_cast<std::uint64_t>(std::chrono::nanoseconds{ time }.count());
+        }
+
+        void record(const char* name, std::uint64_t begin, std::uint64_t end) noexcept;
+    }
+
+    /**
+     * @class Span
+     * @brief Records the time between its construction and its destruction on the calling thread.
+     *
+     * The name is stored as is, it must have static storage duration (e.g. a string literal).
+     */
+    class [[maybe_unused]] Span
+    {
+    public:
+#if defined(GLFW_CPP_ENABLE_TRACE)
+        explicit Span(const char* name) noexcept
+            : m_name{ name }
+            , m_begin{ detail::now() }
+        {
+        }
+
+        ~Span() { detail::record(m_name, m_begin, detail::now()); }
+#else
+        explicit constexpr Span(const char*) noexcept {}
+#endif
+
+        Span(const Span&)            = delete;
+        Span& operator=(const Span&) = delete;
+        Span(Span&&)                 = delete;
+        Span& operator=(Span&&)      = delete;
+
+#if defined(GLFW_CPP_ENABLE_TRACE)
+    private:
+        const char*   m_name;
+        std::uint64_t m_begin;
+#endif
+    };
+
+    /**
+     * @brief Write the spans recorded by every thread as Chrome trace JSON.
+     *
+     * @param out The stream to write to.
+     *
+     * Can be called from any thread while the other threads keep recording; spans that end after the call
+     * may or may not be included.
+     */
+    void dump(std::ostream& out);
+
+    /**
+     * @brief Discard the spans recorded so far.
+     *
+     * Each thread empties its buffer on the next span it records.
+     */
+    void clear() noexcept;
+
+    /**
+     * @brief Get the number of spans dropped because a thread buffer was full since the last `clear()`.
+     */
+    std::size_t dropped() noexcept;
+}
+
+#endif /* end of include guard: GLFW_CPP_TRACE_HPP */
@@ -0,0 +1,640 @@
+#ifndef GLFW_CPP_VULKAN_SWAPCHAIN_HPP
+#define GLFW_CPP_VULKAN_SWAPCHAIN_HPP
+
+#include "glfw_cpp/error.hpp"
+#include "glfw_cpp/event.hpp"
+#include "glfw_cpp/helper.hpp"
+#include "glfw_cpp/vulkan.hpp"
+#include "glfw_cpp/window.hpp"
+
+#if not defined(VK_VERSION_1_0)
+    #error "Include <vulkan/vulkan.h> (or define GLFW_CPP_INCLUDE_VULKAN_H) before including this header"
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace glfw_cpp::vk
+{
+    /**
+     * @struct SwapchainConfig
+     * @brief Configuration of a `Swapchain`.
+     *
+     * The handles are borrowed; they must outlive the swapchain.
+     */
+    struct SwapchainConfig
+    {
+        VkInstance       instance        = VK_NULL_HANDLE;
+        VkPhysicalDevice physical_device = VK_NULL_HANDLE;
+        VkDevice         device          = VK_NULL_HANDLE;
+        VkSurfaceKHR     surface         = VK_NULL_HANDLE;
+
+        // queue families that access the images; more than one distinct family means concurrent sharing
+        std::vector<std::uint32_t> queue_families = {};
+
+        VkSurfaceFormatKHR format = { VK_FORMAT_B8G8R8A8_SRGB, VK_COLOR_SPACE_SRGB_NONLINEAR_KHR };
+        VkImageUsageFlags  usage  = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+
+        // the first mode supported by the surface is used, FIFO is always the fallback
+        std::vector<VkPresentModeKHR> present_modes = {
+            VK_PRESENT_MODE_MAILBOX_KHR,
+            VK_PRESENT_MODE_IMMEDIATE_KHR,
+            VK_PRESENT_MODE_FIFO_RELAXED_KHR,
+            VK_PRESENT_MODE_FIFO_KHR,
+        };
+
+        // timeline semaphore signaled by the work of each frame, tells when a replaced swapchain is unused;
+        // without it the device is waited idle before replaced swapchains are destroyed
+        VkSemaphore timeline = VK_NULL_HANDLE;
+
+        std::chrono::milliseconds debounce     = std::chrono::milliseconds{ 50 };    // resize quiet period
+        std::uint32_t             retire_after = 3;    // presents before waiting idle, without `timeline`
+        std::uint32_t             min_images   = 3;    // clamped to the surface capabilities
+    };
+
+    /**
+     * @class Swapchain
+     * @brief Swapchain manager driven by the window event queue.
+     *
+     * The swapchain is not recreated on every `FramebufferResized` event; a resize only marks the swapchain
+     * stale and the recreation happens in `acquire()` once no resize has been seen for the debounce period
+     * (the stale swapchain is still presented in the meantime). A suboptimal swapchain is recreated once the
+     * debounce period elapsed since it was first reported, and one that is out of date is recreated right
+     * away.
+     *
+     * The recreation itself never waits for the device to go idle: the new swapchain is created with the
+     * current one as `oldSwapchain`, and the replaced swapchain and its image views are kept alive until the
+     * work using its images is known to be complete:
+     * - With `SwapchainConfig::timeline`, each `present()` passes the value the timeline semaphore reaches
+     *   once the work of that frame completed. A replaced swapchain is destroyed once the semaphore reached
+     *   the last value passed before the replacement, checked on each `present()` without waiting.
+     * - Without it, nothing tells when the images were last used. Once `SwapchainConfig::retire_after` more
+     *   images have been presented, `present()` waits for the device to go idle and destroys every replaced
+     *   swapchain; so the replacements made within a few frames share one idle wait.
+     *
+     * Images, image views, the format, and the extent change on recreation; compare `generation()` against
+     * the value seen when dependent objects (e.g. framebuffers) were created to know when to rebuild them.
+     *
+     * The entry points are resolved through `get_instance_proc_address()` and `vkGetDeviceProcAddr`, so the
+     * Vulkan loader doesn't need to be linked. The object must be used from one thread at a time.
+     *
+     * ```cpp
+     * auto swapchain = glfw_cpp::vk::Swapchain{ window, { .instance = instance, ..., .timeline = sem } };
+     * auto frame     = std::uint64_t{ 0 };
+     *
+     * window.run([&](const auto& events) {
+     *     swapchain.process_events(events);
+     *
+     *     auto image = swapchain.acquire(image_available);
+     *     if (not image) {
+     *         return;    // minimized
+     *     }
+     *
+     *     render(*image, ++frame);    // the submission signals `sem` with `frame`
+     *     swapchain.present(queue, image->index, render_finished, frame);
+     * });
+     * ```
+     */
+    class Swapchain
+    {
+    public:
+        /**
+         * @struct Image
+         * @brief An acquired swapchain image.
+         */
+        struct Image
+        {
+            std::uint32_t index;
+            VkImage       image;
+            VkImageView   view;
+        };
+
+        Swapchain() = default;
+
+        /**
+         * @brief Create the swapchain.
+         *
+         * @param window The window the surface was created for.
+         * @param config The swapchain configuration.
+         *
+         * @throw error::ApiUnavailable If a required Vulkan entry point can't be resolved.
+         * @throw error::PlatformError If a Vulkan call fails.
+         *
+         * The window must outlive the swapchain and must not be moved while the swapchain is alive.
+         */
+        Swapchain(const Window& window, SwapchainConfig config)
+            : m_window{ &window }
+            , m_config{ std::move(config) }
+        {
+            load_functions();
+            recreate();
+        }
+
+        ~Swapchain()
+        {
+            if (m_config.device == VK_NULL_HANDLE) {
+                return;
+            }
+
+            // destruction is the one place where the images must be known to be idle
+            m_fn.device_wait_idle(m_config.device);
+
+            while (not m_retired.empty()) {
+                destroy(m_retired.front().bundle);
+                m_retired.pop_front();
+            }
+            destroy(m_current);
+        }
+
+        Swapchain(Swapchain&& other) noexcept { swap(other); }
+
+        Swapchain& operator=(Swapchain&& other) noexcept
+        {
+            if (this != &other) {
+                auto tmp = Swapchain{ std::move(other) };
+                swap(tmp);
+            }
+            return *this;
+        }
+
+        Swapchain(const Swapchain&)            = delete;
+        Swapchain& operator=(const Swapchain&) = delete;
+
+        /**
+         * @brief Look for resize events in the window event queue.
+         *
+         * @param events The events of the current frame.
+         */
+        void process_events(const EventQueue& events) noexcept
+        {
+            for (const auto& event : events) {
+                if (event.is<event::FramebufferResized>()) {
+                    request_recreate();
+                }
+            }
+        }
+
+        /**
+         * @brief Mark the swapchain stale; it will be recreated once no request was made for the debounce
+         * period.
+         */
+        void request_recreate() noexcept { m_recreate.poke(); }
+
+        /**
+         * @brief Acquire the next image, recreating the swapchain first if needed.
+         *
+         * @param semaphore Semaphore to signal once the image is ready, or `VK_NULL_HANDLE`.
+         * @param fence Fence to signal once the image is ready, or `VK_NULL_HANDLE`.
+         * @param timeout Timeout in nanoseconds.
+         * @return The acquired image, or `std::nullopt` if the framebuffer has zero area (e.g. minimized) or
+         * the acquisition timed out; in that case nothing is signaled and the frame should be skipped.
+         *
+         * @throw error::PlatformError If a Vulkan call fails.
+         */
+        std::optional<Image> acquire(
+            VkSemaphore   semaphore,
+            VkFence       fence   = VK_NULL_HANDLE,
+            std::uint64_t timeout = std::numeric_limits<std::uint64_t>::max()
+        )
+        {
+            if (m_current.swapchain == VK_NULL_HANDLE or m_recreate.due(m_config.debounce)) {
+                if (not recreate()) {
+                    return std::nullopt;
+                }
+            }
+
+            for (auto attempt = 0; attempt < 2; ++attempt) {
+                auto index  = std::uint32_t{};
+                auto result = m_fn.acquire_next_image(
+                    m_config.device, m_current.swapchain, timeout, semaphore, fence, &index
+                );
+
+                switch (result) {
+                case VK_SUBOPTIMAL_KHR: m_recreate.request(); [[fallthrough]];
+                case VK_SUCCESS: return Image{ index, m_current.images[index], m_current.views[index] };
+                case VK_TIMEOUT: [[fallthrough]];
+                case VK_NOT_READY: return std::nullopt;
+                case VK_ERROR_OUT_OF_DATE_KHR:
+                    if (not recreate()) {
+                        return std::nullopt;
+                    }
+                    continue;
+                default: check(result, "vkAcquireNextImageKHR");
+                }
+            }
+
+            return std::nullopt;
+        }
+
+        /**
+         * @brief Present an acquired image.
+         *
+         * @param queue The queue to present on.
+         * @param index The index of the image returned by `acquire()`.
+         * @param wait Semaphores to wait on before presenting.
+         * @param completion The value `SwapchainConfig::timeline` reaches once the work using the image
+         * completed; must be given and non-decreasing if the timeline is set, ignored otherwise.
+         * @return The result of `vkQueuePresentKHR`; out of date and suboptimal results are handled here.
+         *
+         * @throw error::PlatformError If the presentation fails for other reasons.
+         *
+         * Replaced swapchains whose images are no longer in use are destroyed here.
+         */
+        VkResult present(
+            VkQueue                      queue,
+            std::uint32_t                index,
+            std::span<const VkSemaphore> wait       = {},
+            std::uint64_t                completion = 0
+        )
+        {
+            auto info = VkPresentInfoKHR{
+                .sType              = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR,
+                .pNext              = nullptr,
+                .waitSemaphoreCount = static_cast<std::uint32_t>(wait.size()),
+                .pWaitSemaphores    = wait.data(),
+                .swapchainCount     = 1,
+                .pSwapchains        = &m_current.swapchain,
+                .pImageIndices      = &index,
+                .pResults           = nullptr,
+            };
+
+            auto result = m_fn.queue_present(queue, &info);
+            switch (result) {
+            case VK_SUCCESS: break;
+            case VK_SUBOPTIMAL_KHR: m_recreate.request(); break;
+            case VK_ERROR_OUT_OF_DATE_KHR: m_recreate.expedite(); break;    // unusable, don't wait
+            default: check(result, "vkQueuePresentKHR");
+            }
+
+            ++m_presents;
+            m_completion = std::max(m_completion, completion);
+            destroy_retired();
+
+            return result;
+        }
+
+        /**
+         * @brief Present an acquired image waiting on a single semaphore.
+         */
+        VkResult present(VkQueue queue, std::uint32_t index, VkSemaphore wait, std::uint64_t completion = 0)
+        {
+            return present(queue, index, std::span{ &wait, 1 }, completion);
+        }
+
+        /**
+         * @brief Get the number of replaced swapchains that are not destroyed yet.
+         */
+        std::size_t retired_count() const noexcept { return m_retired.size(); }
+
+        // clang-format off
+        VkSwapchainKHR              handle()       const noexcept { return m_current.swapchain; }
+        VkSurfaceFormatKHR          format()       const noexcept { return m_current.format; }
+        VkExtent2D                  extent()       const noexcept { return m_current.extent; }
+        VkPresentModeKHR            present_mode() const noexcept { return m_current.present_mode; }
+        std::span<const VkImage>    images()       const noexcept { return m_current.images; }
+        std::span<const VkImageView> image_views() const noexcept { return m_current.views; }
+        std::uint64_t               generation()   const noexcept { return m_generation; }
+        // clang-format on
+
+    private:
+        struct Functions
+        {
+            // clang-format off
+            PFN_vkGetPhysicalDeviceSurfaceCapabilitiesKHR get_capabilities   = nullptr;
+            PFN_vkGetPhysicalDeviceSurfaceFormatsKHR      get_formats        = nullptr;
+            PFN_vkGetPhysicalDeviceSurfacePresentModesKHR get_present_modes  = nullptr;
+            PFN_vkGetDeviceProcAddr                       get_device_proc    = nullptr;
+            PFN_vkCreateSwapchainKHR                      create_swapchain   = nullptr;
+            PFN_vkDestroySwapchainKHR                     destroy_swapchain  = nullptr;
+            PFN_vkGetSwapchainImagesKHR                   get_images         = nullptr;
+            PFN_vkAcquireNextImageKHR                     acquire_next_image = nullptr;
+            PFN_vkQueuePresentKHR                         queue_present      = nullptr;
+            PFN_vkCreateImageView                         create_image_view  = nullptr;
+            PFN_vkDestroyImageView                        destroy_image_view = nullptr;
+            PFN_vkDeviceWaitIdle                          device_wait_idle   = nullptr;
+            PFN_vkGetSemaphoreCounterValue                get_counter_value  = nullptr;    // with timeline
+            // clang-format on
+        };
+
+        struct Bundle
+        {
+            VkSwapchainKHR           swapchain    = VK_NULL_HANDLE;
+            VkSurfaceFormatKHR       format       = {};
+            VkExtent2D               extent       = {};
+            VkPresentModeKHR         present_mode = VK_PRESENT_MODE_FIFO_KHR;
+            std::vector<VkImage>     images;
+            std::vector<VkImageView> views;
+        };
+
+        struct Retired
+        {
+            Bundle        bundle;
+            std::uint64_t destroy_at;    // present count, without timeline
+            std::uint64_t completion;    // timeline value, with timeline
+        };
+
+        static void check(VkResult result, const char* what)
+        {
+            if (result < VK_SUCCESS) {
+                throw error::PlatformError{ what };
+            }
+        }
+
+        template <typename Fn>
+        static Fn require(Proc proc, const char* name)
+        {
+            if (proc == nullptr) {
+                throw error::ApiUnavailable{ name };
+            }
+            return reinterpret_cast<Fn>(proc);
+        }
+
+        void load_functions()
+        {
+            auto instance = [&]<typename Fn>(Fn& fn, const char* name) {
+                fn = require<Fn>(get_instance_proc_address(m_config.instance, name), name);
+            };
+            auto device = [&]<typename Fn>(Fn& fn, const char* name) {
+                fn = require<Fn>(m_fn.get_device_proc(m_config.device, name), name);
+            };
+
+            // clang-format off
+            instance(m_fn.get_capabilities,   "vkGetPhysicalDeviceSurfaceCapabilitiesKHR");
+            instance(m_fn.get_formats,        "vkGetPhysicalDeviceSurfaceFormatsKHR");
+            instance(m_fn.get_present_modes,  "vkGetPhysicalDeviceSurfacePresentModesKHR");
+            instance(m_fn.get_device_proc,    "vkGetDeviceProcAddr");
+            device  (m_fn.create_swapchain,   "vkCreateSwapchainKHR");
+            device  (m_fn.destroy_swapchain,  "vkDestroySwapchainKHR");
+            device  (m_fn.get_images,         "vkGetSwapchainImagesKHR");
+            device  (m_fn.acquire_next_image, "vkAcquireNextImageKHR");
+            device  (m_fn.queue_present,      "vkQueuePresentKHR");
+            device  (m_fn.create_image_view,  "vkCreateImageView");
+            device  (m_fn.destroy_image_view, "vkDestroyImageView");
+            device  (m_fn.device_wait_idle,   "vkDeviceWaitIdle");
+            // clang-format on
+
+            if (m_config.timeline != VK_NULL_HANDLE) {
+                // core in Vulkan 1.2, VK_KHR_timeline_semaphore before
+                auto proc = m_fn.get_device_proc(m_config.device, "vkGetSemaphoreCounterValue");
+                if (proc == nullptr) {
+                    proc = m_fn.get_device_proc(m_config.device, "vkGetSemaphoreCounterValueKHR");
+                }
+                using Fn               = PFN_vkGetSemaphoreCounterValue;
+                m_fn.get_counter_value = require<Fn>(proc, "vkGetSemaphoreCounterValue");
+            }
+        }
+
+        template <typename T, typename Fn, typename... Args>
+        static std::vector<T> enumerate(Fn fn, const char* name, Args... args)
+        {
+            auto count = std::uint32_t{};
+            check(fn(args..., &count, nullptr), name);
+            auto values = std::vector<T>(count);
+            check(fn(args..., &count, values.data()), name);
+            values.resize(count);
+            return values;
+        }
+
+        VkSurfaceFormatKHR choose_format() const
+        {
+            auto [phys, surface] = std::pair{ m_config.physical_device, m_config.surface };
+            auto formats         = enumerate<VkSurfaceFormatKHR>(
+                m_fn.get_formats, "vkGetPhysicalDeviceSurfaceFormatsKHR", phys, surface
+            );
+
+            auto wanted = m_config.format;
+            auto found  = std::ranges::find_if(formats, [&](const VkSurfaceFormatKHR& format) {
+                return format.format == wanted.format and format.colorSpace == wanted.colorSpace;
+            });
+
+            if (found != formats.end() or formats.empty()) {
+                return wanted;
+            }
+            return formats.front();
+        }
+
+        VkPresentModeKHR choose_present_mode() const
+        {
+            auto [phys, surface] = std::pair{ m_config.physical_device, m_config.surface };
+            auto modes           = enumerate<VkPresentModeKHR>(
+                m_fn.get_present_modes, "vkGetPhysicalDeviceSurfacePresentModesKHR", phys, surface
+            );
+
+            for (auto mode : m_config.present_modes) {
+                if (std::ranges::find(modes, mode) != modes.end()) {
+                    return mode;
+                }
+            }
+            return VK_PRESENT_MODE_FIFO_KHR;
+        }
+
+        VkExtent2D choose_extent(const VkSurfaceCapabilitiesKHR& caps) const
+        {
+            if (caps.currentExtent.width != std::numeric_limits<std::uint32_t>::max()) {
+                return caps.currentExtent;
+            }
+
+            auto [width, height] = m_window->snapshot().framebuffer_size;
+            return {
+                .width  = std::clamp(
+                    static_cast<std::uint32_t>(width), caps.minImageExtent.width, caps.maxImageExtent.width
+                ),
+                .height = std::clamp(
+                    static_cast<std::uint32_t>(height), caps.minImageExtent.height, caps.maxImageExtent.height
+                ),
+            };
+        }
+
+        /**
+         * @brief Replace the current swapchain; returns false if the framebuffer has zero area.
+         */
+        bool recreate()
+        {
+            auto caps = VkSurfaceCapabilitiesKHR{};
+            check(
+                m_fn.get_capabilities(m_config.physical_device, m_config.surface, &caps),
+                "vkGetPhysicalDeviceSurfaceCapabilitiesKHR"
+            );
+
+            auto extent = choose_extent(caps);
+            if (extent.width == 0 or extent.height == 0) {
+                return false;    // stays stale, retried on the next acquire
+            }
+
+            auto image_count = std::max(m_config.min_images, caps.minImageCount);
+            if (caps.maxImageCount != 0) {
+                image_count = std::min(image_count, caps.maxImageCount);
+            }
+
+            auto families = m_config.queue_families;
+            std::ranges::sort(families);
+            families.erase(std::ranges::unique(families).begin(), families.end());
+            auto concurrent = families.size() > 1;
+
+            auto next = Bundle{
+                .swapchain    = VK_NULL_HANDLE,
+                .format       = choose_format(),
+                .extent       = extent,
+                .present_mode = choose_present_mode(),
+                .images       = {},
+                .views        = {},
+            };
+
+            auto info = VkSwapchainCreateInfoKHR{
+                .sType                 = VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR,
+                .pNext                 = nullptr,
+                .flags                 = 0,
+                .surface               = m_config.surface,
+                .minImageCount         = image_count,
+                .imageFormat           = next.format.format,
+                .imageColorSpace       = next.format.colorSpace,
+                .imageExtent           = extent,
+                .imageArrayLayers      = 1,
+                .imageUsage            = m_config.usage,
+                .imageSharingMode      = concurrent ? VK_SHARING_MODE_CONCURRENT : VK_SHARING_MODE_EXCLUSIVE,
+                .queueFamilyIndexCount = concurrent ? static_cast<std::uint32_t>(families.size()) : 0,
+                .pQueueFamilyIndices   = concurrent ? families.data() : nullptr,
+                .preTransform          = caps.currentTransform,
+                .compositeAlpha        = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR,
+                .presentMode           = next.present_mode,
+                .clipped               = VK_TRUE,
+                .oldSwapchain          = m_current.swapchain,
+            };
+
+            check(
+                m_fn.create_swapchain(m_config.device, &info, nullptr, &next.swapchain),
+                "vkCreateSwapchainKHR"
+            );
+
+            try {
+                next.images = enumerate<VkImage>(
+                    m_fn.get_images, "vkGetSwapchainImagesKHR", m_config.device, next.swapchain
+                );
+                create_views(next);
+            } catch (...) {
+                destroy(next);
+                throw;
+            }
+
+            if (m_current.swapchain != VK_NULL_HANDLE) {
+                m_retired.push_back({
+                    .bundle     = std::exchange(m_current, {}),
+                    .destroy_at = m_presents + m_config.retire_after,
+                    .completion = m_completion,
+                });
+            }
+
+            m_current = std::move(next);
+            m_recreate.clear();
+            ++m_generation;
+
+            return true;
+        }
+
+        void create_views(Bundle& bundle) const
+        {
+            bundle.views.reserve(bundle.images.size());
+            for (auto image : bundle.images) {
+                auto info = VkImageViewCreateInfo{
+                    .sType            = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO,
+                    .pNext            = nullptr,
+                    .flags            = 0,
+                    .image            = image,
+                    .viewType         = VK_IMAGE_VIEW_TYPE_2D,
+                    .format           = bundle.format.format,
+                    .components       = {},
+                    .subresourceRange = {
+                        .aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT,
+                        .baseMipLevel   = 0,
+                        .levelCount     = 1,
+                        .baseArrayLayer = 0,
+                        .layerCount     = 1,
+                    },
+                };
+
+                auto view = VkImageView{};
+                check(m_fn.create_image_view(m_config.device, &info, nullptr, &view), "vkCreateImageView");
+                bundle.views.push_back(view);
+            }
+        }
+
+        /**
+         * @brief Destroy the replaced swapchains whose images are known to be unused.
+         */
+        void destroy_retired()
+        {
+            if (m_retired.empty()) {
+                return;
+            }
+
+            if (m_config.timeline != VK_NULL_HANDLE) {
+                auto completed = std::uint64_t{};
+                check(
+                    m_fn.get_counter_value(m_config.device, m_config.timeline, &completed),
+                    "vkGetSemaphoreCounterValue"
+                );
+                while (not m_retired.empty() and m_retired.front().completion <= completed) {
+                    destroy(m_retired.front().bundle);
+                    m_retired.pop_front();
+                }
+                return;
+            }
+
+            if (m_presents < m_retired.front().destroy_at) {
+                return;
+            }
+
+            // everything submitted so far is complete once idle, including the work of later replacements
+            check(m_fn.device_wait_idle(m_config.device), "vkDeviceWaitIdle");
+            while (not m_retired.empty()) {
+                destroy(m_retired.front().bundle);
+                m_retired.pop_front();
+            }
+        }
+
+        void destroy(Bundle& bundle) const noexcept
+        {
+            for (auto view : bundle.views) {
+                m_fn.destroy_image_view(m_config.device, view, nullptr);
+            }
+            if (bundle.swapchain != VK_NULL_HANDLE) {
+                m_fn.destroy_swapchain(m_config.device, bundle.swapchain, nullptr);
+            }
+            bundle = {};
+        }
+
+        void swap(Swapchain& other) noexcept
+        {
+            std::swap(m_window, other.m_window);
+            std::swap(m_config, other.m_config);
+            std::swap(m_fn, other.m_fn);
+            std::swap(m_current, other.m_current);
+            std::swap(m_retired, other.m_retired);
+            std::swap(m_presents, other.m_presents);
+            std::swap(m_completion, other.m_completion);
+            std::swap(m_generation, other.m_generation);
+            std::swap(m_recreate, other.m_recreate);
+        }
+
+        const Window*       m_window = nullptr;
+        SwapchainConfig     m_config = {};
+        Functions           m_fn     = {};
+        Bundle              m_current;
+        std::deque<Retired> m_retired;
+
+        std::uint64_t           m_presents   = 0;
+        std::uint64_t           m_completion = 0;    // last timeline value passed to `present()`
+        std::uint64_t           m_generation = 0;
+        helper::time::Debouncer m_recreate;    // pending recreation, see `request_recreate()`
+    };
+}
+
+#endif /* end of include guard: GLFW_CPP_VULKAN_SWAPCHAIN_HPP */
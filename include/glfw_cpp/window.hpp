@@ -2,14 +2,23 @@
 #define GLFW_CPP_WINDOW_HPP
 
 #include "glfw_cpp/event.hpp"
+#include "glfw_cpp/helper.hpp"
 #include "glfw_cpp/input.hpp"
 #include "glfw_cpp/instance.hpp"
 #include "glfw_cpp/monitor.hpp"
+#include "glfw_cpp/result.hpp"
 
+#include <atomic>
+#include <chrono>
+#include <concepts>
+#include <condition_variable>
+#include <cstdint>
 #include <functional>
 #include <mutex>
 #include <optional>
 #include <string>
+#include <type_traits>
+#include <variant>
 
 struct GLFWwindow;
 
@@ -17,6 +26,14 @@ namespace glfw_cpp
 {
     class Instance;
 
+    namespace co
+    {
+        class NextFrame;
+
+        template <event::Event E>
+        class NextEvent;
+    }
+
     struct Dimensions
     {
         int  width;
@@ -63,12 +80,154 @@ namespace glfw_cpp
         Position               position;
         Dimensions             dimensions;
         FramebufferSize        framebuffer_size;
+        ContentScale           content_scale;
         CursorPosition         cursor_position;
         MouseButtonStateRecord mouse_button_state;
         KeyStateRecord         key_state;
         Monitor                monitor;
     };
 
+    /**
+     * @struct Snapshot
+     * @brief Trivially copyable copy of the window `Properties` and `Attributes`, see `Window::snapshot()`.
+     *
+     * The `title` and `monitor` properties are left out; they are only updated on user request and are read
+     * through `Window::properties()`.
+     */
+    struct Snapshot
+    {
+        Position               position;
+        Dimensions             dimensions;
+        FramebufferSize        framebuffer_size;
+        ContentScale           content_scale;
+        CursorPosition         cursor_position;
+        MouseButtonStateRecord mouse_button_state;
+        KeyStateRecord         key_state;
+        Attributes             attributes;
+    };
+
+    static_assert(std::is_trivially_copyable_v<Snapshot>);
+
+    /**
+     * @brief Bits telling which parts of the window state changed between two `Window::swap_events()`, see
+     * `Window::dirty_mask()`.
+     *
+     * ```cpp
+     * const auto& events = window.swap_events();
+     * if (window.is_dirty(glfw_cpp::dirty::FramebufferSize | glfw_cpp::dirty::ContentScale)) {
+     *     update_viewport(window.snapshot().framebuffer_size);
+     * }
+     * ```
+     */
+    namespace dirty
+    {
+        using Mask = std::uint32_t;
+
+        enum Bit : Mask
+        {
+            Position         = 0x01,
+            Dimensions       = 0x02,
+            FramebufferSize  = 0x04,
+            ContentScale     = 0x08,
+            CursorPosition   = 0x10,
+            MouseButtonState = 0x20,
+            KeyState         = 0x40,
+            Attributes       = 0x80,
+        };
+
+        inline constexpr Mask all = 0xFF;
+    }
+
+    /**
+     * @brief Policies on how `WindowResized` and `FramebufferResized` events are delivered to the event
+     * queue.
+     *
+     * Dragging a window edge produces a flood of resize events. These policies throttle the delivery of the
+     * events only; `Properties::dimensions` and `Properties::framebuffer_size` are always updated as soon as
+     * the events arrive.
+     */
+    namespace resize
+    {
+        /**
+         * @struct Immediate
+         * @brief Every resize event is delivered as it arrives (the default).
+         */
+        struct Immediate
+        {
+        };
+
+        /**
+         * @struct LatestPerFrame
+         * @brief Only the latest resize event of each kind is delivered on each `Window::swap_events()`.
+         */
+        struct LatestPerFrame
+        {
+        };
+
+        /**
+         * @struct Debounce
+         * @brief The latest resize event of each kind is delivered once no resize event arrived for the
+         * quiet period.
+         *
+         * The elapsed time is checked on `Window::swap_events()`, so the events are delivered on the first
+         * swap after the quiet period.
+         */
+        struct Debounce
+        {
+            std::chrono::milliseconds quiet = std::chrono::milliseconds{ 100 };
+        };
+
+        using Policy = std::variant<Immediate, LatestPerFrame, Debounce>;
+    }
+
+    /**
+     * @brief Modes on how the window buffers are swapped, see `Window::set_swap_mode()`.
+     */
+    namespace swap
+    {
+        /**
+         * @struct Immediate
+         * @brief Buffers are swapped as soon as possible, without waiting for vertical retrace.
+         *
+         * Corresponds to `glfwSwapInterval(0)`.
+         */
+        struct Immediate
+        {
+            bool operator==(const Immediate&) const = default;
+        };
+
+        /**
+         * @struct Vsync
+         * @brief Buffers are swapped after `interval` vertical retraces (the default).
+         *
+         * Corresponds to `glfwSwapInterval(interval)`; an interval of 2 on a 60 Hz display presents at 30 Hz.
+         */
+        struct Vsync
+        {
+            int interval = 1;
+
+            bool operator==(const Vsync&) const = default;
+        };
+
+        /**
+         * @struct Adaptive
+         * @brief Like `Vsync`, but a frame that misses the retrace is swapped immediately (allowing tearing)
+         * instead of waiting for the next one.
+         *
+         * Corresponds to `glfwSwapInterval(-interval)`. Requires `WGL_EXT_swap_control_tear` or
+         * `GLX_EXT_swap_control_tear`; if neither is supported by the context, `Vsync` with the same interval
+         * is used instead.
+         */
+        struct Adaptive
+        {
+            int interval = 1;
+
+            bool operator==(const Adaptive&) const = default;
+        };
+
+        using Mode = std::variant<Immediate, Vsync, Adaptive>;
+    }
+
     /**
      * @class Window
      * @brief Wrapper class for `GLFWwindow`.
@@ -157,13 +316,45 @@ namespace glfw_cpp
          *
          * @throw error::NoWindowContext If the window doesn't have a context (i.e. Api::NoApi).
          *
-         * Corresponds to `glfwSwapInterval(1)` on true or `glfwSwapInterval(0)` on false.
-         *
-         * If the window context is not current at the point of calling, this function will bind it
-         * temporarily before restoring it to previously bound context.
+         * Equivalent to `set_swap_mode(swap::Vsync{})` on true or `set_swap_mode(swap::Immediate{})` on
+         * false; see there for when the change is applied.
          */
         void set_vsync(bool value);
 
+        /**
+         * @brief Set how the window buffers are swapped.
+         *
+         * @param mode The swap mode, see `swap::Mode`.
+         *
+         * @throw error::NoWindowContext If the window doesn't have a context (i.e. Api::NoApi).
+         * @throw error::PlatformError If platform-specific error occurs.
+         *
+         * The swap interval is a state of the context, so it can only be set by the thread the context is
+         * current on. If the window context is current on the calling thread, the mode is applied right away.
+         * Otherwise it is applied by the next `swap_buffers()` called while the context is current, so this
+         * function never binds the context itself. Use `effective_swap_mode()` to see what was applied.
+         *
+         * Swapping without the context current is allowed by GLFW, but the pending mode is then never
+         * applied; call this function from the thread the context is current on in that case.
+         */
+        void set_swap_mode(swap::Mode mode);
+
+        /**
+         * @brief Non-throwing version of `set_vsync()`.
+         *
+         * @return `ErrorCode::NoWindowContext` if the window doesn't have a context, or the error reported by
+         * GLFW.
+         */
+        Result<void> set_vsync_noexcept(bool value) noexcept;
+
+        /**
+         * @brief Non-throwing version of `set_swap_mode()`.
+         *
+         * @return `ErrorCode::NoWindowContext` if the window doesn't have a context, or the error reported by
+         * GLFW.
+         */
+        Result<void> set_swap_mode_noexcept(swap::Mode mode) noexcept;
+
         /**
          * @brief Set whether the window should be resizable by the user.
          *
@@ -286,6 +477,26 @@ namespace glfw_cpp
          */
         const EventQueue& swap_events() noexcept;
 
+        /**
+         * @brief Request a new frame even though no event arrived.
+         *
+         * Wakes up `wait_for_events()` (and thus `run_on_demand()`). The request is consumed by the next
+         * `swap_events()`. This function can be called from any thread.
+         */
+        void invalidate() noexcept;
+
+        /**
+         * @brief Block until an event is queued, the window is invalidated, or the window should close.
+         *
+         * @param timeout The maximum time to wait, or `std::nullopt` to wait indefinitely.
+         * @return False if the timeout elapsed, true otherwise.
+         *
+         * Resize events held back by the resize policy count once they are due. Events are queued by
+         * `Instance::poll_events()` or `Instance::wait_events()` on the main thread, so this function should
+         * be called from another thread (e.g. the render thread of the window).
+         */
+        bool wait_for_events(std::optional<std::chrono::milliseconds> timeout = std::nullopt);
+
         /**
          * @brief See last events queued before call to `swap_events()`
          *
@@ -314,6 +525,14 @@ namespace glfw_cpp
          */
         double swap_buffers();
 
+        /**
+         * @brief Non-throwing version of `swap_buffers()`.
+         *
+         * @return The time taken between the last call to `swap_buffers()` and the current call, or the error
+         * reported by GLFW.
+         */
+        Result<double> swap_buffers_noexcept() noexcept;
+
         /**
          * @brief Use window, check if the window should close, swap events, and swap the window buffers at
          * the same time.
@@ -372,13 +591,83 @@ namespace glfw_cpp
             glfw_cpp::make_current(prev);
         }
 
+        /**
+         * @brief Run the window loop, rendering only when there is something new to show.
+         *
+         * @param func The function to be called between swapping events and swapping buffers. If it returns
+         * `bool`, true requests another frame right away (e.g. an animation is running).
+         *
+         * Like `run()`, but instead of rendering continuously, a frame is only rendered when events were
+         * queued, the window was invalidated with `invalidate()`, or `func` returned true for the previous
+         * frame; otherwise the loop blocks on `wait_for_events()`. The first frame is always rendered.
+         *
+         * For imgui windows, return `imgui::wants_redraw(events)` from `func`, with the events it was given.
+         */
+        template <typename Fn>
+            requires std::invocable<Fn&, const EventQueue&>
+        void run_on_demand(Fn&& func)
+        {
+            auto prev = glfw_cpp::get_current();
+            glfw_cpp::make_current(handle());
+
+            auto again = true;
+            while (not should_close()) {
+                if (not again) {
+                    wait_for_events();
+                    if (should_close()) {
+                        break;
+                    }
+                }
+
+                const auto& events = swap_events();
+                if constexpr (std::same_as<std::invoke_result_t<Fn&, const EventQueue&>, bool>) {
+                    again = func(events);
+                } else {
+                    func(events);
+                    again = false;
+                }
+                swap_buffers();
+            }
+
+            glfw_cpp::make_current(prev);
+        }
+
+        /**
+         * @brief Wait for the next frame in a `co::Task`, see `glfw_cpp/coroutine.hpp`.
+         *
+         * @return An awaiter resuming on the next `co::Runner::tick()` with the events of that frame.
+         *
+         * Defined in `glfw_cpp/coroutine.hpp`. The awaiting task must run on the runner of this window.
+         */
+        co::NextFrame next_frame() noexcept;
+
+        /**
+         * @brief Wait for the next event of a type in a `co::Task`, see `glfw_cpp/coroutine.hpp`.
+         *
+         * @tparam E The event type.
+         *
+         * @return An awaiter resuming with the next event of type `E` delivered by `co::Runner::tick()`.
+         *
+         * Defined in `glfw_cpp/coroutine.hpp`. The awaiting task must run on the runner of this window.
+         */
+        template <event::Event E>
+        co::NextEvent<E> next() noexcept;
+
         /**
          * @brief Request the window to close.
          *
-         * Corresponds to `glfwSetWindowShouldClose`.
+         * Corresponds to `glfwSetWindowShouldClose`. Also wakes up `wait_for_events()`.
          */
         void request_close() noexcept;
 
+        /**
+         * @brief Cancel a close request, e.g. after asking the user to confirm on `WindowClosed`.
+         *
+         * Corresponds to `glfwSetWindowShouldClose` with `GLFW_FALSE`, and counts the window as open again
+         * for `Instance::has_window_opened()`; setting the flag with GLFW directly does not.
+         */
+        void cancel_close() noexcept;
+
         /**
          * @brief Set the mouse capture state.
          *
@@ -395,10 +684,64 @@ namespace glfw_cpp
          */
         void resize_event_queue(std::size_t new_size) noexcept;
 
+        /**
+         * @brief Index the events of the event queues by type.
+         *
+         * @param enabled Whether to maintain the index.
+         *
+         * Makes `EventQueue::count()`, `EventQueue::last()`, and `EventQueue::of_type()` on the queue
+         * returned by `swap_events()` follow the index instead of scanning the queue.
+         */
+        void set_event_type_index(bool enabled) noexcept;
+
+        /**
+         * @brief Set what happens when an event arrives while the event queue is full.
+         *
+         * @param policy The policy, see `overflow::Policy`.
+         *
+         * The default is `overflow::Overwrite`. Queues grown by `overflow::Grow` keep their capacity until
+         * `resize_event_queue()` is called.
+         */
+        void set_overflow_policy(overflow::Policy policy) noexcept;
+
+        /**
+         * @brief Get the current event queue overflow policy.
+         */
+        overflow::Policy overflow_policy() const noexcept;
+
+        /**
+         * @brief Get the number of events dropped so far because the event queue or its priority lane was
+         * full, per event type.
+         */
+        EventDrops dropped_events() const noexcept;
+
+        /**
+         * @brief Reset the dropped events counters.
+         */
+        void reset_dropped_events() noexcept;
+
+        /**
+         * @brief Set how resize events are delivered to the event queue.
+         *
+         * @param policy The policy, see `resize::Policy`.
+         *
+         * Resize events held back by the previous policy are delivered on the next `swap_events()` if the new
+         * policy allows it.
+         */
+        void set_resize_policy(resize::Policy policy) noexcept;
+
+        /**
+         * @brief Get the current resize event policy.
+         */
+        resize::Policy resize_policy() const noexcept;
+
         /**
          * @brief Get the properties of the window.
          *
          * @return The properties of the window.
+         *
+         * The properties are updated by the main thread as the events arrive. Reading them on another thread
+         * (e.g. a render thread) races with those updates, use `snapshot()` there instead.
          */
         const Properties& properties() const noexcept { return m_properties; }
 
@@ -406,29 +749,84 @@ namespace glfw_cpp
          * @brief Get the attributes of the window.
          *
          * @return The attributes of the window.
+         *
+         * Same as `properties()`, use `snapshot()` on threads other than the main thread.
          */
         const Attributes& attributes() const noexcept { return m_attributes; }
 
+        /**
+         * @brief Get a consistent copy of the properties and attributes of the window.
+         *
+         * @return The latest properties (without `title` and `monitor`) and attributes published.
+         *
+         * Safe to call from any thread. The copy is published after each update, the call never blocks nor
+         * takes a lock; it only retries the copy if an update was written concurrently.
+         */
+        Snapshot snapshot() const noexcept { return m_snapshot.load(); }
+
+        /**
+         * @brief Get the parts of the window state that changed in the frame of the last `swap_events()`.
+         *
+         * @return A combination of `dirty::Bit`.
+         *
+         * The changes are accumulated as the properties and attributes are updated (by events or by the
+         * setters of this class) and latched by `swap_events()`, so the mask stays the same until the next
+         * swap. A new window reports every part as changed, up to and including its first `swap_events()`.
+         */
+        dirty::Mask dirty_mask() const noexcept { return m_dirty; }
+
+        /**
+         * @brief Check whether any of the given parts of the window state changed, see `dirty_mask()`.
+         *
+         * @param mask A combination of `dirty::Bit`.
+         */
+        bool is_dirty(dirty::Mask mask) const noexcept { return (m_dirty & mask) != 0; }
+
         /**
          * @brief Get last frame time.
          */
         double delta_time() const noexcept { return m_delta_time; }
 
         /**
-         * @brief Check whether the window vsync is enabled.
+         * @brief Check whether the requested swap mode waits for vertical retrace (not `swap::Immediate`).
+         */
+        bool is_vsync() const noexcept;
+
+        /**
+         * @brief Get the requested swap mode.
          */
-        bool is_vsync() const noexcept { return m_vsync; }
+        swap::Mode swap_mode() const noexcept;
+
+        /**
+         * @brief Get the swap mode in effect on the context.
+         *
+         * @return The applied mode, or `std::nullopt` if the requested mode has not been applied yet.
+         *
+         * This differs from `swap_mode()` while a change is pending, or when `swap::Adaptive` was requested
+         * but the context does not support it (`swap::Vsync` is reported instead).
+         */
+        std::optional<swap::Mode> effective_swap_mode() const noexcept;
 
         /**
          * @brief Check whether the mouse is captured.
          */
         bool is_mouse_captured() const noexcept { return m_capture_mouse; }
 
+        /**
+         * @brief Check whether the window has a context (created with an API other than `Api::NoApi`).
+         */
+        bool has_context() const noexcept { return m_has_context; }
+
         /**
          * @brief Get the underlying `GLFWwindow` handle.
          */
         Handle handle() const noexcept { return m_handle; }
 
+        /**
+         * @brief Get the id of the window in the instance window registry.
+         */
+        WindowId id() const noexcept { return m_id; }
+
         /**
          * @brief Boolean conversion to check whether the underlying handle is null or not.
          *
@@ -437,26 +835,54 @@ namespace glfw_cpp
         explicit operator bool() noexcept { return m_handle != nullptr; }
 
     private:
-        Window(Handle handle, Properties&& properties, Attributes&& attributes);
+        Window(Handle handle, WindowId id, Properties&& properties, Attributes&& attributes);
 
         void push_event(Event&& event) noexcept;
+        void push_back_event(Event&& event) noexcept;    // push to the back queue, requires m_queue_mutex
+        void publish_snapshot() noexcept;                // requires m_queue_mutex
+        void release_resize_events() noexcept;
+        bool resize_events_due() const noexcept;
+        bool apply_swap_mode() noexcept;    // returns whether a pending mode was applied
         void update_delta_time() noexcept;
 
-        Handle m_handle = nullptr;
+        Handle   m_handle = nullptr;
+        WindowId m_id     = {};
 
-        // window stuff
-        Properties m_properties      = {};
-        Attributes m_attributes      = {};
-        double     m_last_frame_time = 0.0;
-        double     m_delta_time      = 0.0;
-        bool       m_vsync           = true;
-        bool       m_capture_mouse   = false;
-        bool       m_has_context     = false;
+        // window stuff (properties and attributes are written with m_queue_mutex held, then published)
+        Properties                      m_properties      = {};
+        Attributes                      m_attributes      = {};
+        helper::sync::SeqLock<Snapshot> m_snapshot        = {};
+        dirty::Mask                     m_dirty           = dirty::all;    // latched by swap_events
+        dirty::Mask                     m_dirty_back      = dirty::all;    // protected by m_queue_mutex
+        double                          m_last_frame_time = 0.0;
+        double                          m_delta_time      = 0.0;
+        bool                            m_capture_mouse   = false;
+        bool                            m_has_context     = false;
 
         // queues
-        EventQueue         m_event_queue_front = EventQueue{ s_default_eventqueue_size };
-        EventQueue         m_event_queue_back  = EventQueue{ s_default_eventqueue_size };
-        mutable std::mutex m_queue_mutex;
+        EventQueue              m_event_queue_front = EventQueue{ s_default_eventqueue_size };
+        EventQueue              m_event_queue_back  = EventQueue{ s_default_eventqueue_size };
+        PriorityLane            m_priority_lane;                // critical events of the back queue
+        mutable std::mutex      m_queue_mutex;
+        std::condition_variable m_queue_cv;                     // notified on push, invalidate, close request
+        bool                    m_invalidated       = false;    // protected by m_queue_mutex
+
+        // what to do when the back queue is full and the events it dropped (protected by m_queue_mutex)
+        overflow::Policy m_overflow_policy = overflow::Overwrite{};
+        EventDrops       m_dropped         = {};
+
+        // resize events held back by the resize policy (protected by m_queue_mutex)
+        resize::Policy                           m_resize_policy = resize::Immediate{};
+        std::optional<event::WindowResized>      m_pending_window_resize;
+        std::optional<event::FramebufferResized> m_pending_framebuffer_resize;
+        std::chrono::steady_clock::time_point    m_last_resize;
+
+        // swap mode requested by the user and the one applied to the context (protected by m_swap_mutex)
+        swap::Mode                m_swap_mode           = swap::Vsync{};
+        std::optional<swap::Mode> m_swap_mode_effective = std::nullopt;
+        std::atomic<bool>         m_swap_mode_dirty     = false;    // checked without the lock
+        std::optional<bool>       m_swap_tear           = std::nullopt;    // swap_control_tear support
+        mutable std::mutex        m_swap_mutex;
     };
 }
 
@@ -0,0 +1,134 @@
+#ifndef GLFW_CPP_WINDOW_REGISTRY_HPP
+#define GLFW_CPP_WINDOW_REGISTRY_HPP
+
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <vector>
+
+struct GLFWwindow;
+
+namespace glfw_cpp
+{
+    /**
+     * @struct WindowId
+     * @brief Stable identifier of a window in the `Instance` registry.
+     *
+     * The slot index is reused once the window is destroyed but the generation is not, so an id never refers
+     * to another window.
+     */
+    struct WindowId
+    {
+        std::uint32_t index      = std::numeric_limits<std::uint32_t>::max();
+        std::uint32_t generation = 0;
+
+        bool operator==(const WindowId&) const = default;
+    };
+
+    /**
+     * @class WindowRegistry
+     * @brief Slot map of the windows created by an `Instance`, with a count of the windows still open.
+     *
+     * Insertion, removal, and lookup are O(1). A window counts as open from its insertion until it is marked
+     * closed (and not marked open again) or removed, the count can be read from any thread without locking.
+     */
+    class WindowRegistry
+    {
+    public:
+        WindowRegistry() = default;
+
+        WindowRegistry(const WindowRegistry&)            = delete;
+        WindowRegistry& operator=(const WindowRegistry&) = delete;
+
+        /**
+         * @brief Register an open window.
+         *
+         * @param handle The window handle.
+         *
+         * @return The id of the window.
+         */
+        WindowId insert(GLFWwindow* handle);
+
+        /**
+         * @brief Unregister a window.
+         *
+         * @param id The id of the window.
+         *
+         * @return The handle of the window, or `nullptr` if the id does not refer to a registered window.
+         */
+        GLFWwindow* erase(WindowId id) noexcept;
+
+        /**
+         * @brief Get the handle of a window.
+         *
+         * @param id The id of the window.
+         *
+         * @return The handle of the window, or `nullptr` if the id does not refer to a registered window.
+         */
+        GLFWwindow* get(WindowId id) const noexcept;
+
+        /**
+         * @brief Mark a window as closed.
+         *
+         * @param id The id of the window.
+         *
+         * @return True if the window was open.
+         */
+        bool mark_closed(WindowId id) noexcept;
+
+        /**
+         * @brief Mark a closed window as open again, for a cancelled close.
+         *
+         * @param id The id of the window.
+         *
+         * @return True if the window was closed.
+         */
+        bool mark_open(WindowId id) noexcept;
+
+        /**
+         * @brief Get the number of registered windows that are not marked as closed.
+         */
+        std::size_t open_count() const noexcept { return m_open.load(std::memory_order::acquire); }
+
+        /**
+         * @brief Get the number of registered windows.
+         */
+        std::size_t size() const noexcept;
+
+        /**
+         * @brief Call a function with the handle of each registered window.
+         */
+        template <std::invocable<GLFWwindow*> Fn>
+        void for_each(Fn&& fn) const
+        {
+            auto lock = std::scoped_lock{ m_mutex };
+            for (const auto& slot : m_slots) {
+                if (slot.handle != nullptr) {
+                    fn(slot.handle);
+                }
+            }
+        }
+
+    private:
+        struct Slot
+        {
+            GLFWwindow*   handle     = nullptr;
+            std::uint32_t generation = 0;
+            bool          open       = false;
+        };
+
+        Slot*       find(WindowId id) noexcept;    // requires m_mutex
+        const Slot* find(WindowId id) const noexcept;
+
+        std::vector<Slot>          m_slots;
+        std::vector<std::uint32_t> m_free;    // capacity kept at m_slots.size() so that erase never allocates
+        std::size_t                m_size = 0;
+        std::atomic<std::size_t>   m_open = 0;
+        mutable std::mutex         m_mutex;    // the windows can be closed from any thread
+    };
+}
+
+#endif /* end of include guard: GLFW_CPP_WINDOW_REGISTRY_HPP */
@@ -0,0 +1,733 @@
+#include "glfw_cpp/capture.hpp"
+#include "glfw_cpp/error.hpp"
+#include "glfw_cpp/instance.hpp"
+#include "glfw_cpp/window.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <format>
+#include <limits>
+#include <mutex>
+#include <span>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+#if defined(_WIN32)
+    #define WIN32_LEAN_AND_MEAN
+    #define NOMINMAX
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <unistd.h>
+#endif
+
+// gl tricks
+// ---------
+// glfw-cpp doesn't link to any OpenGL loader, so the handful of functions needed here are loaded manually
+// through `get_proc_address` from the current context.
+namespace gl_
+{
+#if defined(_WIN32) && !defined(_WIN64)
+    #define GLFW_CPP_GLAPIENTRY __stdcall
+#else
+    #define GLFW_CPP_GLAPIENTRY
+#endif
+
+    using GLenum     = unsigned int;
+    using GLuint     = unsigned int;
+    using GLint      = int;
+    using GLsizei    = int;
+    using GLbitfield = unsigned int;
+    using GLboolean  = unsigned char;
+    using GLintptr   = std::intptr_t;
+    using GLsizeiptr = std::intptr_t;
+    using GLuint64   = std::uint64_t;
+    using GLsync     = struct __GLsync*;
+
+    constexpr GLenum     PIXEL_PACK_BUFFER          = 0x88EB;
+    constexpr GLenum     PIXEL_PACK_BUFFER_BINDING  = 0x88ED;
+    constexpr GLenum     STREAM_READ                = 0x88E1;
+    constexpr GLenum     READ_FRAMEBUFFER           = 0x8CA8;
+    constexpr GLenum     READ_FRAMEBUFFER_BINDING   = 0x8CAA;
+    constexpr GLenum     PACK_ALIGNMENT             = 0x0D05;
+    constexpr GLenum     RGBA                       = 0x1908;
+    constexpr GLenum     UNSIGNED_BYTE              = 0x1401;
+    constexpr GLbitfield MAP_READ_BIT               = 0x0001;
+    constexpr GLenum     SYNC_GPU_COMMANDS_COMPLETE = 0x9117;
+    constexpr GLbitfield SYNC_FLUSH_COMMANDS_BIT    = 0x0001;
+    constexpr GLenum     ALREADY_SIGNALED           = 0x911A;
+    constexpr GLenum     CONDITION_SATISFIED        = 0x911C;
+    constexpr GLenum     WAIT_FAILED                = 0x911D;
+
+    struct Functions
+    {
+        // clang-format off
+        void      (GLFW_CPP_GLAPIENTRY* GenBuffers)    (GLsizei, GLuint*);
+        void      (GLFW_CPP_GLAPIENTRY* DeleteBuffers) (GLsizei, const GLuint*);
+        void      (GLFW_CPP_GLAPIENTRY* BindBuffer)    (GLenum, GLuint);
+        void      (GLFW_CPP_GLAPIENTRY* BufferData)    (GLenum, GLsizeiptr, const void*, GLenum);
+        void*     (GLFW_CPP_GLAPIENTRY* MapBufferRange)(GLenum, GLintptr, GLsizeiptr, GLbitfield);
+        GLboolean (GLFW_CPP_GLAPIENTRY* UnmapBuffer)   (GLenum);
+        void      (GLFW_CPP_GLAPIENTRY* ReadPixels)    (GLint, GLint, GLsizei, GLsizei, GLenum, GLenum, void*);
+        void      (GLFW_CPP_GLAPIENTRY* GetIntegerv)   (GLenum, GLint*);
+        void      (GLFW_CPP_GLAPIENTRY* PixelStorei)   (GLenum, GLint);
+        void      (GLFW_CPP_GLAPIENTRY* BindFramebuffer)(GLenum, GLuint);
+        GLsync    (GLFW_CPP_GLAPIENTRY* FenceSync)     (GLenum, GLbitfield);
+        GLenum    (GLFW_CPP_GLAPIENTRY* ClientWaitSync)(GLsync, GLbitfield, GLuint64);
+        void      (GLFW_CPP_GLAPIENTRY* DeleteSync)    (GLsync);
+        // clang-format on
+
+        template <typename F>
+        static bool load(F& fn, const char* name) noexcept
+        {
+            fn = reinterpret_cast<F>(glfw_cpp::get_proc_address_noexcept(name));
+            return fn != nullptr;
+        }
+
+        bool load_all() noexcept
+        {
+            return load(GenBuffers, "glGenBuffers")                  //
+               and load(DeleteBuffers, "glDeleteBuffers")            //
+               and load(BindBuffer, "glBindBuffer")                  //
+               and load(BufferData, "glBufferData")                  //
+               and load(MapBufferRange, "glMapBufferRange")          //
+               and load(UnmapBuffer, "glUnmapBuffer")                //
+               and load(ReadPixels, "glReadPixels")                  //
+               and load(GetIntegerv, "glGetIntegerv")                //
+               and load(PixelStorei, "glPixelStorei")                //
+               and load(BindFramebuffer, "glBindFramebuffer")        //
+               and load(FenceSync, "glFenceSync")                    //
+               and load(ClientWaitSync, "glClientWaitSync")          //
+               and load(DeleteSync, "glDeleteSync");
+        }
+    };
+
+#undef GLFW_CPP_GLAPIENTRY
+}
+// ---------
+
+namespace
+{
+    using namespace glfw_cpp::capture;
+
+    /**
+     * @class MappedFile
+     * @brief Append-only file written through a memory mapping that grows geometrically.
+     */
+    class MappedFile
+    {
+    public:
+        MappedFile(const std::filesystem::path& path, std::size_t reserve)
+        {
+            reserve = std::max<std::size_t>(reserve, 4096);
+#if defined(_WIN32)
+            m_file = CreateFileW(
+                path.c_str(),
+                GENERIC_READ | GENERIC_WRITE,
+                FILE_SHARE_READ,
+                nullptr,
+                CREATE_ALWAYS,
+                FILE_ATTRIBUTE_NORMAL,
+                nullptr
+            );
+            if (m_file == INVALID_HANDLE_VALUE) {
+                auto msg = std::format("Failed to open capture file '{}'", path.string());
+                throw glfw_cpp::error::PlatformError{ msg.c_str() };
+            }
+#else
+            m_fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+            if (m_fd < 0) {
+                auto msg = std::format("Failed to open capture file '{}'", path.string());
+                throw glfw_cpp::error::PlatformError{ msg.c_str() };
+            }
+#endif
+            try {
+                remap(reserve);
+            } catch (...) {
+                close();
+                throw;
+            }
+        }
+
+        ~MappedFile() { close(); }
+
+        MappedFile(MappedFile&&)            = delete;
+        MappedFile& operator=(MappedFile&&) = delete;
+
+        /**
+         * @brief Get a writable region of at least `size` bytes at the end of the file.
+         *
+         * The region is only valid until the next call to this function.
+         */
+        std::span<std::byte> acquire(std::size_t size)
+        {
+            if (m_size + size > m_capacity) {
+                remap(std::max(m_capacity * 2, m_size + size));
+            }
+            return { m_data + m_size, size };
+        }
+
+        /**
+         * @brief Mark `size` bytes of the last acquired region as written.
+         */
+        void commit(std::size_t size) noexcept
+        {
+            assert(m_size + size <= m_capacity);
+            m_size += size;
+        }
+
+    private:
+        void close() noexcept
+        {
+            unmap();
+#if defined(_WIN32)
+            if (m_file != INVALID_HANDLE_VALUE) {
+                auto size     = LARGE_INTEGER{};
+                size.QuadPart = static_cast<LONGLONG>(m_size);
+                SetFilePointerEx(m_file, size, nullptr, FILE_BEGIN);
+                SetEndOfFile(m_file);
+                CloseHandle(m_file);
+            }
+            m_file = INVALID_HANDLE_VALUE;
+#else
+            if (m_fd >= 0) {
+                [[maybe_unused]] auto res = ::ftruncate(m_fd, static_cast<off_t>(m_size));
+                ::close(m_fd);
+            }
+            m_fd = -1;
+#endif
+        }
+
+        void unmap() noexcept
+        {
+#if defined(_WIN32)
+            if (m_data != nullptr) {
+                UnmapViewOfFile(m_data);
+            }
+            if (m_mapping != nullptr) {
+                CloseHandle(m_mapping);
+            }
+            m_mapping = nullptr;
+#else
+            if (m_data != nullptr) {
+                ::munmap(m_data, m_capacity);
+            }
+#endif
+            m_data = nullptr;
+        }
+
+        void remap(std::size_t capacity)
+        {
+            unmap();
+#if defined(_WIN32)
+            auto high = static_cast<DWORD>(static_cast<std::uint64_t>(capacity) >> 32);
+            auto low  = static_cast<DWORD>(capacity & 0xFFFF'FFFF);
+
+            m_mapping = CreateFileMappingW(m_file, nullptr, PAGE_READWRITE, high, low, nullptr);
+            if (m_mapping == nullptr) {
+                throw glfw_cpp::error::PlatformError{ "Failed to create capture file mapping" };
+            }
+            auto* ptr = MapViewOfFile(m_mapping, FILE_MAP_WRITE, 0, 0, capacity);
+            if (ptr == nullptr) {
+                throw glfw_cpp::error::PlatformError{ "Failed to map capture file" };
+            }
+#else
+            if (::ftruncate(m_fd, static_cast<off_t>(capacity)) != 0) {
+                throw glfw_cpp::error::PlatformError{ "Failed to grow capture file" };
+            }
+            auto* ptr = ::mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+            if (ptr == MAP_FAILED) {
+                throw glfw_cpp::error::PlatformError{ "Failed to map capture file" };
+            }
+#endif
+            m_data     = static_cast<std::byte*>(ptr);
+            m_capacity = capacity;
+        }
+
+#if defined(_WIN32)
+        HANDLE m_file    = INVALID_HANDLE_VALUE;
+        HANDLE m_mapping = nullptr;
+#else
+        int m_fd = -1;
+#endif
+        std::byte*  m_data     = nullptr;
+        std::size_t m_capacity = 0;
+        std::size_t m_size     = 0;
+    };
+}
+
+namespace glfw_cpp::capture::detail
+{
+    std::size_t encode_raw(const std::byte* src, std::uint32_t width, std::uint32_t height, std::byte* dst)
+    {
+        const auto stride = std::size_t{ width } * 4;
+        for (std::size_t y = 0; y < height; ++y) {
+            std::memcpy(dst + y * stride, src + (height - 1 - y) * stride, stride);
+        }
+        return stride * height;
+    }
+
+    std::size_t qoi_max_size(std::uint32_t width, std::uint32_t height)
+    {
+        return std::size_t{ width } * height * 5 + 14 + 8;
+    }
+
+    std::size_t encode_qoi(const std::byte* src, std::uint32_t width, std::uint32_t height, std::byte* dst)
+    {
+        struct Px
+        {
+            std::uint8_t r, g, b, a;
+            bool         operator==(const Px&) const = default;
+        };
+
+        auto out     = reinterpret_cast<std::uint8_t*>(dst);
+        auto write   = [&](std::uint8_t byte) { *out++ = byte; };
+        auto write32 = [&](std::uint32_t value) {
+            write(static_cast<std::uint8_t>(value >> 24));
+            write(static_cast<std::uint8_t>(value >> 16));
+            write(static_cast<std::uint8_t>(value >> 8));
+            write(static_cast<std::uint8_t>(value));
+        };
+
+        for (auto c : { 'q', 'o', 'i', 'f' }) {
+            write(static_cast<std::uint8_t>(c));
+        }
+        write32(width);
+        write32(height);
+        write(4);    // channels
+        write(0);    // sRGB with linear alpha
+
+        auto index = std::array<Px, 64>{};
+        auto prev  = Px{ 0, 0, 0, 255 };
+        auto run   = 0;
+
+        const auto stride = std::size_t{ width } * 4;
+        const auto total  = std::size_t{ width } * height;
+        auto       count  = std::size_t{ 0 };
+
+        for (auto y = height; y-- > 0;) {
+            const auto* row = reinterpret_cast<const std::uint8_t*>(src + y * stride);
+
+            for (std::size_t x = 0; x < width; ++x, ++count) {
+                auto px = Px{ row[x * 4 + 0], row[x * 4 + 1], row[x * 4 + 2], row[x * 4 + 3] };
+
+                if (px == prev) {
+                    if (++run == 62 or count + 1 == total) {
+                        write(static_cast<std::uint8_t>(0xC0 | (run - 1)));
+                        run = 0;
+                    }
+                    continue;
+                }
+
+                if (run > 0) {
+                    write(static_cast<std::uint8_t>(0xC0 | (run - 1)));
+                    run = 0;
+                }
+
+                auto hash = (px.r * 3 + px.g * 5 + px.b * 7 + px.a * 11) % 64;
+
+                auto& slot = index[static_cast<std::size_t>(hash)];
+
+                if (slot == px) {
+                    write(static_cast<std::uint8_t>(hash));
+                    prev = px;
+                    continue;
+                }
+
+                slot = px;
+
+                if (px.a == prev.a) {
+                    auto vr   = static_cast<std::int8_t>(px.r - prev.r);
+                    auto vg   = static_cast<std::int8_t>(px.g - prev.g);
+                    auto vb   = static_cast<std::int8_t>(px.b - prev.b);
+                    auto vg_r = vr - vg;
+                    auto vg_b = vb - vg;
+
+                    if (vr > -3 and vr < 2 and vg > -3 and vg < 2 and vb > -3 and vb < 2) {
+                        write(static_cast<std::uint8_t>(0x40 | ((vr + 2) << 4) | ((vg + 2) << 2) | (vb + 2)));
+                    } else if (vg_r > -9 and vg_r < 8 and vg > -33 and vg < 32 and vg_b > -9 and vg_b < 8) {
+                        write(static_cast<std::uint8_t>(0x80 | (vg + 32)));
+                        write(static_cast<std::uint8_t>(((vg_r + 8) << 4) | (vg_b + 8)));
+                    } else {
+                        write(0xFE);
+                        write(px.r);
+                        write(px.g);
+                        write(px.b);
+                    }
+                } else {
+                    write(0xFF);
+                    write(px.r);
+                    write(px.g);
+                    write(px.b);
+                    write(px.a);
+                }
+
+                prev = px;
+            }
+        }
+
+        for (auto i = 0; i < 7; ++i) {
+            write(0x00);
+        }
+        write(0x01);
+
+        return static_cast<std::size_t>(out - reinterpret_cast<std::uint8_t*>(dst));
+    }
+}
+
+namespace glfw_cpp::capture
+{
+    struct FrameCapture::Impl
+    {
+        enum class State : int
+        {
+            Free,       // available for a new readback
+            Pending,    // readback issued, fence not yet signaled
+            Mapped,     // mapped and handed to the encoder
+            Encoded,    // encoder done, waiting to be unmapped by the render thread
+        };
+
+        struct Slot
+        {
+            gl_::GLuint        pbo          = 0;
+            gl_::GLsync        fence        = nullptr;
+            std::size_t        capacity     = 0;
+            std::uint32_t      width        = 0;
+            std::uint32_t      height       = 0;
+            std::uint64_t      timestamp_ns = 0;
+            const std::byte*   data         = nullptr;
+            std::atomic<State> state        = State::Free;
+        };
+
+        Impl(const Window& window, Config config)
+            : gl{ load_functions(window) }
+            , window{ &window }
+            , format{ config.format }
+            , slots(std::max<std::size_t>(config.ring_size, 2))
+            , file{ config.path, config.reserve }
+        {
+            auto header = FileHeader{};
+            auto region = file.acquire(sizeof(header));
+            std::memcpy(region.data(), &header, sizeof(header));
+            file.commit(sizeof(header));
+            bytes.fetch_add(sizeof(header), std::memory_order_relaxed);
+
+            auto pbos = std::vector<gl_::GLuint>(slots.size());
+            gl.GenBuffers(static_cast<gl_::GLsizei>(pbos.size()), pbos.data());
+            for (std::size_t i = 0; i < slots.size(); ++i) {
+                slots[i].pbo = pbos[i];
+            }
+
+            encoder = std::jthread{ [this](std::stop_token st) { encode_loop(st); } };
+        }
+
+        ~Impl()
+        {
+            flush();
+
+            encoder.request_stop();
+            encoder.join();
+
+            reclaim();
+
+            for (auto& slot : slots) {
+                gl.DeleteBuffers(1, &slot.pbo);
+            }
+        }
+
+        void capture()
+        {
+            collect(false);
+            reclaim();
+
+            auto [width, height] = window->snapshot().framebuffer_size;
+            if (width <= 0 or height <= 0) {
+                return;    // iconified or not yet mapped, nothing to read
+            }
+
+            auto& slot = slots[head];
+            if (slot.state.load(std::memory_order_acquire) != State::Free) {
+                dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+
+            const auto size = static_cast<std::size_t>(width) * static_cast<std::size_t>(height) * 4;
+
+            auto prev_pack  = gl_::GLint{};
+            auto prev_read  = gl_::GLint{};
+            auto prev_align = gl_::GLint{};
+            gl.GetIntegerv(gl_::PIXEL_PACK_BUFFER_BINDING, &prev_pack);
+            gl.GetIntegerv(gl_::READ_FRAMEBUFFER_BINDING, &prev_read);
+            gl.GetIntegerv(gl_::PACK_ALIGNMENT, &prev_align);
+
+            gl.BindFramebuffer(gl_::READ_FRAMEBUFFER, 0);
+            gl.BindBuffer(gl_::PIXEL_PACK_BUFFER, slot.pbo);
+            if (slot.capacity < size) {
+                auto bytes = static_cast<gl_::GLsizeiptr>(size);
+                gl.BufferData(gl_::PIXEL_PACK_BUFFER, bytes, nullptr, gl_::STREAM_READ);
+                slot.capacity = size;
+            }
+            gl.PixelStorei(gl_::PACK_ALIGNMENT, 4);
+            gl.ReadPixels(0, 0, width, height, gl_::RGBA, gl_::UNSIGNED_BYTE, nullptr);
+
+            slot.fence        = gl.FenceSync(gl_::SYNC_GPU_COMMANDS_COMPLETE, 0);
+            slot.width        = static_cast<std::uint32_t>(width);
+            slot.height       = static_cast<std::uint32_t>(height);
+            slot.timestamp_ns = now_ns();
+            slot.state.store(State::Pending, std::memory_order_relaxed);
+
+            gl.PixelStorei(gl_::PACK_ALIGNMENT, prev_align);
+            gl.BindBuffer(gl_::PIXEL_PACK_BUFFER, static_cast<gl_::GLuint>(prev_pack));
+            gl.BindFramebuffer(gl_::READ_FRAMEBUFFER, static_cast<gl_::GLuint>(prev_read));
+
+            head = (head + 1) % slots.size();
+            issued.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        void flush()
+        {
+            collect(true);
+
+            auto lock = std::unique_lock{ mutex };
+            idle_cv.wait(lock, [&] { return queue.empty() and not busy; });
+        }
+
+        /**
+         * @brief Map the readbacks whose fence is signaled, in issue order, and hand them to the encoder.
+         */
+        void collect(bool wait)
+        {
+            auto prev_pack = gl_::GLint{};
+            auto bound     = false;
+
+            for (std::size_t n = 0; n < slots.size(); ++n) {
+                auto& slot = slots[tail];
+                if (slot.state.load(std::memory_order_relaxed) != State::Pending) {
+                    break;
+                }
+
+                auto flags   = wait ? gl_::SYNC_FLUSH_COMMANDS_BIT : 0u;
+                auto timeout = wait ? std::numeric_limits<gl_::GLuint64>::max() : 0;
+                auto status  = gl.ClientWaitSync(slot.fence, flags, timeout);
+
+                auto failed = status == gl_::WAIT_FAILED;
+                if (not failed and status != gl_::ALREADY_SIGNALED and status != gl_::CONDITION_SATISFIED) {
+                    break;    // still in flight, try again next frame
+                }
+
+                gl.DeleteSync(slot.fence);
+                slot.fence = nullptr;
+                tail       = (tail + 1) % slots.size();
+
+                // the readback is lost, there is nothing worth mapping
+                if (failed) {
+                    slot.state.store(State::Free, std::memory_order_relaxed);
+                    dropped.fetch_add(1, std::memory_order_relaxed);
+                    continue;
+                }
+
+                if (not std::exchange(bound, true)) {
+                    gl.GetIntegerv(gl_::PIXEL_PACK_BUFFER_BINDING, &prev_pack);
+                }
+
+                const auto size = std::size_t{ slot.width } * slot.height * 4;
+                gl.BindBuffer(gl_::PIXEL_PACK_BUFFER, slot.pbo);
+                auto* ptr = gl.MapBufferRange(
+                    gl_::PIXEL_PACK_BUFFER, 0, static_cast<gl_::GLsizeiptr>(size), gl_::MAP_READ_BIT
+                );
+
+                if (ptr == nullptr) {
+                    slot.state.store(State::Free, std::memory_order_relaxed);
+                    dropped.fetch_add(1, std::memory_order_relaxed);
+                    continue;
+                }
+
+                slot.data = static_cast<const std::byte*>(ptr);
+                slot.state.store(State::Mapped, std::memory_order_release);
+
+                auto lock = std::scoped_lock{ mutex };
+                queue.push_back(&slot);
+                queue_cv.notify_one();
+            }
+
+            if (bound) {
+                gl.BindBuffer(gl_::PIXEL_PACK_BUFFER, static_cast<gl_::GLuint>(prev_pack));
+            }
+        }
+
+        /**
+         * @brief Unmap the buffers the encoder is done with so they can be reused.
+         */
+        void reclaim()
+        {
+            auto prev_pack = gl_::GLint{};
+            auto bound     = false;
+
+            for (auto& slot : slots) {
+                if (slot.state.load(std::memory_order_acquire) != State::Encoded) {
+                    continue;
+                }
+
+                if (not std::exchange(bound, true)) {
+                    gl.GetIntegerv(gl_::PIXEL_PACK_BUFFER_BINDING, &prev_pack);
+                }
+
+                gl.BindBuffer(gl_::PIXEL_PACK_BUFFER, slot.pbo);
+                gl.UnmapBuffer(gl_::PIXEL_PACK_BUFFER);
+                slot.data = nullptr;
+                slot.state.store(State::Free, std::memory_order_relaxed);
+            }
+
+            if (bound) {
+                gl.BindBuffer(gl_::PIXEL_PACK_BUFFER, static_cast<gl_::GLuint>(prev_pack));
+            }
+        }
+
+        void encode_loop(std::stop_token st)
+        {
+            while (true) {
+                auto* slot = [&]() -> Slot* {
+                    auto lock = std::unique_lock{ mutex };
+                    queue_cv.wait(lock, st, [&] { return not queue.empty(); });
+                    if (queue.empty()) {
+                        return nullptr;
+                    }
+                    busy = true;
+                    auto* front = queue.front();
+                    queue.pop_front();
+                    return front;
+                }();
+
+                if (slot == nullptr) {
+                    return;    // stop requested and nothing left to encode
+                }
+
+                try {
+                    encode(*slot);
+                } catch (...) {
+                    dropped.fetch_add(1, std::memory_order_relaxed);    // file couldn't grow, frame is lost
+                }
+                slot->state.store(State::Encoded, std::memory_order_release);
+
+                auto lock = std::scoped_lock{ mutex };
+                busy = false;
+                idle_cv.notify_all();
+            }
+        }
+
+        void encode(const Slot& slot)
+        {
+            auto header = FrameHeader{
+                .width        = slot.width,
+                .height       = slot.height,
+                .format       = format,
+                .timestamp_ns = slot.timestamp_ns,
+            };
+
+            auto max_size = format == Format::Qoi ? detail::qoi_max_size(slot.width, slot.height)
+                                                  : std::size_t{ slot.width } * slot.height * 4;
+
+            auto region  = file.acquire(sizeof(header) + max_size);
+            auto payload = region.data() + sizeof(header);
+
+            switch (format) {
+            case Format::Raw:
+                header.payload_size = detail::encode_raw(slot.data, slot.width, slot.height, payload);
+                break;
+            case Format::Qoi:
+                header.payload_size = detail::encode_qoi(slot.data, slot.width, slot.height, payload);
+                break;
+            }
+
+            std::memcpy(region.data(), &header, sizeof(header));
+            file.commit(sizeof(header) + header.payload_size);
+
+            written.fetch_add(1, std::memory_order_relaxed);
+            bytes.fetch_add(sizeof(header) + header.payload_size, std::memory_order_relaxed);
+        }
+
+        static gl_::Functions load_functions(const Window& window)
+        {
+            if (get_current() != window.handle()) {
+                throw error::NoCurrentContext{ "FrameCapture requires the window context to be current" };
+            }
+
+            auto functions = gl_::Functions{};
+            if (not functions.load_all()) {
+                throw error::VersionUnavailable{
+                    "FrameCapture requires OpenGL 3.2 or OpenGL ES 3.0 (fence sync and buffer mapping)"
+                };
+            }
+
+            return functions;
+        }
+
+        static std::uint64_t now_ns() noexcept
+        {
+            auto now = std::chrono::steady_clock::now().time_since_epoch();
+            auto ns  = std::chrono::duration_cast<std::chrono::nanoseconds>(now);
+            return static_cast<std::uint64_t>(ns.count());
+        }
+
+        gl_::Functions gl;
+
+        const Window*     window;
+        Format            format;
+        std::vector<Slot> slots;
+        std::size_t       head = 0;    // next slot to issue a readback into
+        std::size_t       tail = 0;    // oldest slot that may still be pending
+
+        MappedFile file;    // only touched by the encoder thread after construction
+
+        std::deque<Slot*>           queue;
+        bool                        busy = false;
+        std::mutex                  mutex;
+        std::condition_variable_any queue_cv;
+        std::condition_variable     idle_cv;
+
+        std::atomic<std::size_t>   issued  = 0;
+        std::atomic<std::size_t>   written = 0;
+        std::atomic<std::size_t>   dropped = 0;
+        std::atomic<std::uint64_t> bytes   = 0;
+
+        std::jthread encoder;    // declared last so it starts after and stops before everything else
+    };
+
+    FrameCapture::FrameCapture(const Window& window, Config config)
+        : m_impl{ std::make_unique<Impl>(window, std::move(config)) }
+    {
+    }
+
+    FrameCapture::~FrameCapture() = default;
+
+    FrameCapture::FrameCapture(FrameCapture&&) noexcept            = default;
+    FrameCapture& FrameCapture::operator=(FrameCapture&&) noexcept = default;
+
+    void FrameCapture::capture()
+    {
+        m_impl->capture();
+    }
+
+    void FrameCapture::flush()
+    {
+        m_impl->flush();
+    }
+
+    Stats FrameCapture::stats() const noexcept
+    {
+        return {
+            .issued  = m_impl->issued.load(std::memory_order_relaxed),
+            .written = m_impl->written.load(std::memory_order_relaxed),
+            .dropped = m_impl->dropped.load(std::memory_order_relaxed),
+            .bytes   = m_impl->bytes.load(std::memory_order_relaxed),
+        };
+    }
+}
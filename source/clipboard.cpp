@@ -0,0 +1,129 @@
+#include "glfw_cpp/clipboard.hpp"
+#include "glfw_cpp/instance.hpp"
+#include "glfw_cpp/trace.hpp"
+
+#include "util.hpp"
+
+#define GLFW_INCLUDE_NONE
+#include <GLFW/glfw3.h>
+
+#include <utility>
+
+namespace glfw_cpp
+{
+    task::Future<ClipboardText> Clipboard::read()
+    {
+        if (auto text = cached(); text.has_value()) {
+            return task::make_ready(std::move(*text));
+        }
+        return m_instance.submit_task([this] { return fetch(); });
+    }
+
+    ClipboardText Clipboard::get()
+    {
+        if (auto text = cached(); text.has_value()) {
+            return std::move(*text);
+        }
+        return m_instance.invoke_on_main([this] { return fetch(); });
+    }
+
+    std::optional<ClipboardText> Clipboard::cached() const
+    {
+        auto lock = std::scoped_lock{ m_mutex };
+        return fresh_cache(Clock::now());
+    }
+
+    task::Future<void> Clipboard::set(std::string text)
+    {
+        auto shared = std::make_shared<const std::string>(std::move(text));
+
+        auto generation = std::uint64_t{};
+        {
+            auto lock   = std::scoped_lock{ m_mutex };
+            m_cache     = ClipboardText{ shared };
+            m_cached_at = Clock::now();
+            generation  = ++m_generation;
+        }
+
+        return m_instance.submit_task([this, shared, generation] {
+            util::clear_glfw_error();
+            glfwSetClipboardString(nullptr, shared->c_str());
+
+            if (auto [code, description] = util::take_glfw_error(); code != GLFW_NO_ERROR) {
+                // the cache holds text that never made it to the clipboard, unless it was replaced already
+                {
+                    auto lock = std::scoped_lock{ m_mutex };
+                    if (m_generation == generation) {
+                        m_cache.reset();
+                        ++m_generation;
+                    }
+                }
+                util::throw_error(code, description);
+            }
+        });
+    }
+
+    void Clipboard::invalidate() noexcept
+    {
+        auto lock = std::scoped_lock{ m_mutex };
+        m_cache.reset();
+        ++m_generation;
+    }
+
+    void Clipboard::set_max_age(std::chrono::milliseconds max_age) noexcept
+    {
+        auto lock = std::scoped_lock{ m_mutex };
+        m_max_age = max_age;
+    }
+
+    std::chrono::milliseconds Clipboard::max_age() const noexcept
+    {
+        auto lock = std::scoped_lock{ m_mutex };
+        return m_max_age;
+    }
+
+    std::uint64_t Clipboard::generation() const noexcept
+    {
+        auto lock = std::scoped_lock{ m_mutex };
+        return m_generation;
+    }
+
+    ClipboardText Clipboard::fetch()
+    {
+        auto generation = std::uint64_t{};
+        {
+            // reads queued in the same batch are served by the first one
+            auto lock = std::scoped_lock{ m_mutex };
+            if (auto text = fresh_cache(Clock::now()); text.has_value()) {
+                return std::move(*text);
+            }
+            generation = m_generation;
+        }
+
+        auto span = trace::Span{ "Clipboard::fetch" };
+        util::clear_glfw_error();
+        auto value = glfwGetClipboardString(nullptr);
+        if (auto [code, description] = util::take_glfw_error(); code != GLFW_NO_ERROR) {
+            util::throw_error(code, description);
+        }
+
+        auto text = ClipboardText{ std::make_shared<const std::string>(value != nullptr ? value : "") };
+
+        // the clipboard may have been set or invalidated meanwhile, the cache is then left to the newer state
+        auto lock = std::scoped_lock{ m_mutex };
+        if (m_generation == generation) {
+            m_cache     = text;
+            m_cached_at = Clock::now();
+        }
+
+        return text;
+    }
+
+    std::optional<ClipboardText> Clipboard::fresh_cache(Clock::time_point now) const
+    {
+        if (not m_cache.has_value() or now - m_cached_at >= m_max_age) {
+            return std::nullopt;
+        }
+        return m_cache;
+    }
+}
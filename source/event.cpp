@@ -34,12 +34,15 @@ namespace glfw_cpp
         std::swap(m_capacity, other.m_capacity);
         std::swap(m_begin, other.m_begin);
         std::swap(m_end, other.m_end);
+        std::swap(m_next, other.m_next);
+        std::swap(m_lanes, other.m_lanes);
     }
 
     void EventQueue::reset() noexcept
     {
         m_begin = 0;
         m_end   = 0;
+        m_lanes = {};
     }
 
     void EventQueue::clear() noexcept
@@ -66,6 +69,7 @@ namespace glfw_cpp
                 m_end = npos;
             }
         } else {
+            unlink(m_begin);
             current           = m_begin;
             m_buffer[current] = std::move(event);
             if (++m_begin == capacity()) {
@@ -73,15 +77,40 @@ namespace glfw_cpp
             }
         }
 
+        link_back(current);
         return { this, current };
     }
 
+    std::optional<Event> EventQueue::push(Event&& event, const overflow::Policy& policy) noexcept
+    {
+        if (not full()) {
+            push(std::move(event));
+            return std::nullopt;
+        }
+
+        if (std::holds_alternative<overflow::Reject>(policy)) {
+            return std::move(event);
+        }
+
+        if (auto* grow = std::get_if<overflow::Grow>(&policy); grow and capacity() < grow->max_capacity) {
+            resize(std::min(grow->max_capacity, std::max(capacity() * 2, std::size_t{ 1 })));
+            push(std::move(event));
+            return std::nullopt;
+        }
+
+        auto dropped = std::optional<Event>{ std::in_place, std::move(m_buffer[m_begin]) };
+        push(std::move(event));
+        return dropped;
+    }
+
     std::optional<Event> EventQueue::pop() noexcept
     {
         if (empty()) {
             return std::nullopt;
         }
 
+        unlink(m_begin);
+
         std::optional<Event> value{ std::in_place, std::move(m_buffer[m_begin]) };
         if (m_end == npos) {
             m_end = m_begin;
@@ -93,6 +122,42 @@ namespace glfw_cpp
         return value;
     }
 
+    std::size_t EventQueue::drain_into(std::span<Event> out) noexcept
+    {
+        auto count = std::min(size(), out.size());
+        if (count == 0) {
+            return 0;
+        }
+
+        auto first  = std::min(count, capacity() - m_begin);    // the rest wrapped to the start
+        auto buffer = std::span{ m_buffer.get(), capacity() };
+
+        std::ranges::move(buffer.subspan(m_begin, first), out.begin());
+        std::ranges::move(buffer.first(count - first), out.begin() + static_cast<std::ptrdiff_t>(first));
+
+        // moved-from events keep their type, the index can still be unlinked from them
+        for (std::size_t offset = 0; offset < count and has_type_index(); ++offset) {
+            unlink(at(offset));
+        }
+
+        if (m_end == npos) {
+            m_end = m_begin;
+        }
+        m_begin = (m_begin + count) % capacity();
+
+        return count;
+    }
+
+    std::array<std::span<const Event>, 2> EventQueue::segments() const noexcept
+    {
+        auto count = size();
+        auto first = std::min(count, capacity() - m_begin);
+        return {
+            std::span<const Event>{ m_buffer.get() + m_begin, first },
+            std::span<const Event>{ m_buffer.get(), count - first },
+        };
+    }
+
     void EventQueue::resize(std::size_t new_capacity, ResizePolicy policy) noexcept
     {
         if (new_capacity == capacity()) {
@@ -104,6 +169,7 @@ namespace glfw_cpp
             m_capacity = new_capacity;
             m_begin    = 0;
             m_end      = 0;
+            rebuild_type_index();
 
             return;
         }
@@ -119,6 +185,7 @@ namespace glfw_cpp
             m_end      = m_end == npos ? capacity() : (m_end + capacity() - m_begin) % capacity();
             m_begin    = 0;
             m_capacity = new_capacity;
+            rebuild_type_index();
 
             return;
         }
@@ -147,7 +214,71 @@ namespace glfw_cpp
         m_buffer   = std::move(buffer);
         m_capacity = new_capacity;
         m_begin    = 0;
-        m_end      = count <= new_capacity ? count : npos;
+        m_end      = count < new_capacity ? count : npos;
+        rebuild_type_index();
+    }
+
+    void EventQueue::set_type_index(bool enabled) noexcept
+    {
+        if (enabled == has_type_index()) {
+            return;
+        }
+
+        if (enabled) {
+            m_next = std::make_unique<std::size_t[]>(capacity());
+            relink_type_index();
+        } else {
+            m_next  = nullptr;
+            m_lanes = {};
+        }
+    }
+
+    void EventQueue::link_back(std::size_t index) noexcept
+    {
+        if (not has_type_index()) {
+            return;
+        }
+
+        auto& lane    = m_lanes[m_buffer[index].variant.index()];
+        m_next[index] = npos;
+        if (lane.tail != npos) {
+            m_next[lane.tail] = index;
+        } else {
+            lane.head = index;
+        }
+        lane.tail = index;
+        ++lane.count;
+    }
+
+    void EventQueue::unlink(std::size_t index) noexcept
+    {
+        if (not has_type_index()) {
+            return;
+        }
+
+        // the oldest event of its type is the head of its lane
+        auto& lane = m_lanes[m_buffer[index].variant.index()];
+        lane.head  = m_next[index];
+        if (lane.head == npos) {
+            lane.tail = npos;
+        }
+        --lane.count;
+    }
+
+    void EventQueue::rebuild_type_index() noexcept
+    {
+        if (has_type_index()) {
+            m_next = std::make_unique<std::size_t[]>(capacity());
+            relink_type_index();
+        }
+    }
+
+    void EventQueue::relink_type_index() noexcept
+    {
+        m_lanes = {};
+        for (std::size_t offset = 0; offset < size(); ++offset) {
+            link_back(at(offset));
+        }
     }
 
     EventQueue::Iterator<> EventQueue::begin() noexcept
@@ -179,4 +310,92 @@ namespace glfw_cpp
     {
         return { this, m_end };
     }
+
+    bool PriorityLane::is_critical(const Event& event) noexcept
+    {
+        return event.visit(event::Overload{
+            // clang-format off
+            [](const event::WindowClosed&)    { return true; },
+            [](const event::WindowFocused&)   { return true; },
+            [](const event::FileDropped&)     { return true; },
+            [](const event::KeyPressed& e)    { return e.state == KeyState::Release; },
+            [](const event::ButtonPressed& e) { return e.state == MouseButtonState::Release; },
+            [](const auto&)                   { return false; },
+            // clang-format on
+        });
+    }
+
+    std::optional<Event> PriorityLane::push(
+        EventQueue&             queue,
+        Event&&                 event,
+        const overflow::Policy& policy
+    ) noexcept
+    {
+        if (is_critical(event)) {
+            return push_critical(std::move(event));
+        }
+
+        // a rejected event is not part of the sequence, the queue keeps the events pushed before it
+        auto dropped = queue.push(std::move(event), policy);
+        if (not dropped or not std::holds_alternative<overflow::Reject>(policy)) {
+            ++m_pushed;
+        }
+        return dropped;
+    }
+
+    std::optional<Event> PriorityLane::push_critical(Event&& event) noexcept
+    {
+        if (m_size < s_reserved) {
+            m_events[m_size++] = { m_pushed, std::move(event) };
+            return std::nullopt;
+        }
+
+        // full: a close or a focus change only needs its latest state, it keeps the place of the older one
+        if (event.is<event::WindowClosed>() or event.is<event::WindowFocused>()) {
+            for (auto i = m_size; i-- > 0;) {
+                if (m_events[i].second.variant.index() == event.variant.index()) {
+                    m_events[i].second = std::move(event);
+                    return std::nullopt;
+                }
+            }
+        }
+
+        return std::move(event);
+    }
+
+    void PriorityLane::swap_merged(EventQueue& queue, EventQueue& out) noexcept
+    {
+        if (m_size == 0) {
+            out.swap(queue);
+            queue.reset();
+            m_pushed = 0;
+            return;
+        }
+
+        // the queue holds the latest pushed events, older ones may have been evicted
+        auto index  = m_pushed - queue.size();
+        auto needed = queue.size() + m_size;
+
+        out.reset();
+        if (out.capacity() < needed) {
+            out.resize(needed);
+        }
+
+        auto lane = m_events.begin();
+        auto end  = m_events.begin() + static_cast<std::ptrdiff_t>(m_size);
+        while (auto event = queue.pop()) {
+            for (; lane != end and lane->first <= index; ++lane) {
+                out.push(std::move(lane->second));
+            }
+            out.push(std::move(*event));
+            ++index;
+        }
+        for (; lane != end; ++lane) {
+            out.push(std::move(lane->second));
+        }
+
+        m_size = 0;
+        queue.reset();
+        m_pushed = 0;
+    }
 }
@@ -0,0 +1,208 @@
+#include "glfw_cpp/extension_set.hpp"
+#include "glfw_cpp/instance.hpp"
+
+#include "util.hpp"
+
+#define GLFW_INCLUDE_NONE
+#include <GLFW/glfw3.h>
+
+#include <atomic>
+#include <charconv>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#if defined(_WIN32)
+    #define GLFW_CPP_GL_APIENTRY __stdcall
+#else
+    #define GLFW_CPP_GL_APIENTRY
+#endif
+
+namespace
+{
+    using GetStringFn   = const unsigned char*(GLFW_CPP_GL_APIENTRY*)(unsigned int);
+    using GetStringiFn  = const unsigned char*(GLFW_CPP_GL_APIENTRY*)(unsigned int, unsigned int);
+    using GetIntegervFn = void(GLFW_CPP_GL_APIENTRY*)(unsigned int, int*);
+
+    constexpr unsigned int GL_VERSION        = 0x1F02;
+    constexpr unsigned int GL_EXTENSIONS     = 0x1F03;
+    constexpr unsigned int GL_NUM_EXTENSIONS = 0x821D;
+
+    struct Entry
+    {
+        GLFWwindow*                                       context;
+        std::unique_ptr<const glfw_cpp::gl::ExtensionSet> set;
+    };
+
+    std::mutex         g_sets_mutex;
+    std::vector<Entry> g_sets;    // protected by g_sets_mutex
+
+    // bumped when a set is dropped so the per-thread fast paths of every thread are invalidated
+    std::atomic<std::uint64_t> g_sets_epoch = 1;
+
+    struct LastUsed
+    {
+        GLFWwindow*                       context = nullptr;
+        const glfw_cpp::gl::ExtensionSet* set     = nullptr;
+        std::uint64_t                     epoch   = 0;
+    };
+
+    thread_local LastUsed t_last_used = {};
+
+    // "4.6.0 NVIDIA 550.54", "OpenGL ES 3.2 Mesa 24.0", "OpenGL ES-CM 1.1 ..."
+    int major_version(std::string_view version) noexcept
+    {
+        if (auto pos = version.find_first_of("0123456789"); pos != std::string_view::npos) {
+            version.remove_prefix(pos);
+        }
+
+        auto major = 0;
+        std::from_chars(version.data(), version.data() + version.size(), major);
+        return major;
+    }
+
+    template <typename Fn>
+    Fn get_proc(glfw_cpp::gl::GetProc* loader, const char* name)
+    {
+        auto proc = reinterpret_cast<Fn>(loader != nullptr ? loader(name) : glfwGetProcAddress(name));
+        if (loader == nullptr) {
+            util::check_glfw_error();
+        }
+
+        // with the non-immediate error policies the check above doesn't throw
+        if (proc == nullptr) {
+            throw glfw_cpp::error::NoCurrentContext{ "Can't enumerate extensions without a current context" };
+        }
+        return proc;
+    }
+}
+
+namespace glfw_cpp::gl
+{
+    ExtensionSet::ExtensionSet(GetProc* loader)
+    {
+        auto get_string = get_proc<GetStringFn>(loader, "glGetString");
+
+        auto version = reinterpret_cast<const char*>(get_string(GL_VERSION));
+        auto offsets = std::vector<std::pair<std::size_t, std::size_t>>{};
+
+        if (version != nullptr and major_version(version) >= 3) {
+            // GL_EXTENSIONS is not queryable with glGetString on core profiles
+            auto get_stringi  = get_proc<GetStringiFn>(loader, "glGetStringi");
+            auto get_integerv = get_proc<GetIntegervFn>(loader, "glGetIntegerv");
+
+            auto count = 0;
+            get_integerv(GL_NUM_EXTENSIONS, &count);
+
+            for (auto i = 0u; i < static_cast<unsigned int>(count); ++i) {
+                if (auto name = get_stringi(GL_EXTENSIONS, i); name != nullptr) {
+                    auto view = std::string_view{ reinterpret_cast<const char*>(name) };
+                    offsets.emplace_back(m_names.size(), view.size());
+                    m_names.append(view);
+                }
+            }
+        } else if (auto names = get_string(GL_EXTENSIONS); names != nullptr) {
+            m_names = reinterpret_cast<const char*>(names);
+
+            auto start = std::size_t{ 0 };
+            while (start < m_names.size()) {
+                auto end = m_names.find(' ', start);
+                if (end == std::string::npos) {
+                    end = m_names.size();
+                }
+                if (end > start) {
+                    offsets.emplace_back(start, end - start);
+                }
+                start = end + 1;
+            }
+        }
+
+        // the views are made once the storage stops growing
+        auto names = std::string_view{ m_names };
+        m_extensions.reserve(offsets.size());
+        for (auto [offset, size] : offsets) {
+            m_extensions.insert(names.substr(offset, size));
+        }
+    }
+
+    bool ExtensionSet::contains(std::string_view extension) const
+    {
+        if (m_extensions.contains(extension)) {
+            return true;
+        }
+        if (extension.starts_with("GL_")) {
+            return false;
+        }
+
+        auto name = std::string{ extension };
+        {
+            std::scoped_lock lock{ m_platform_mutex };
+            if (auto found = m_platform.find(name); found != m_platform.end()) {
+                return found->second;
+            }
+        }
+
+        // queried outside the lock; threads racing on the same name get the same answer
+        auto supported = glfwExtensionSupported(name.c_str()) == GLFW_TRUE;
+        util::check_glfw_error();
+
+        std::scoped_lock lock{ m_platform_mutex };
+        m_platform.emplace(std::move(name), supported);
+        return supported;
+    }
+
+    const ExtensionSet& current_extensions()
+    {
+        auto context = glfw_cpp::get_current();
+        if (context == nullptr) {
+            throw error::NoCurrentContext{ "Can't get the extensions without a current context" };
+        }
+
+        return current_extensions(context, nullptr);
+    }
+
+    const ExtensionSet& current_extensions(GLFWwindow* context, GetProc* loader)
+    {
+        auto& last = t_last_used;
+        if (last.context == context and last.epoch == g_sets_epoch.load(std::memory_order::acquire)) {
+            return *last.set;
+        }
+
+        const ExtensionSet* set = nullptr;
+        {
+            std::scoped_lock lock{ g_sets_mutex };
+            for (const auto& entry : g_sets) {
+                if (entry.context == context) {
+                    set = entry.set.get();
+                    break;
+                }
+            }
+        }
+
+        // built outside the lock; only the thread the context is current on can build its set
+        if (set == nullptr) {
+            auto built = std::make_unique<const ExtensionSet>(loader);
+            set        = built.get();
+
+            std::scoped_lock lock{ g_sets_mutex };
+            g_sets.push_back({ .context = context, .set = std::move(built) });
+        }
+
+        last = {
+            .context = context,
+            .set     = set,
+            .epoch   = g_sets_epoch.load(std::memory_order::acquire),
+        };
+        return *set;
+    }
+
+    void forget_extensions(GLFWwindow* context) noexcept
+    {
+        std::scoped_lock lock{ g_sets_mutex };
+        auto erased = std::erase_if(g_sets, [&](const Entry& entry) { return entry.context == context; });
+        if (erased > 0) {
+            g_sets_epoch.fetch_add(1, std::memory_order::release);
+        }
+    }
+}
@@ -1,4 +1,5 @@
 #include "glfw_cpp/input.hpp"
+#include "glfw_cpp/instance.hpp"
 
 #include "util.hpp"
 
@@ -254,6 +255,10 @@ namespace glfw_cpp
     {
         glfwSetClipboardString(nullptr, string);
         util::check_glfw_error();
+
+        if (Instance::s_instance != nullptr) {
+            Instance::s_instance->m_clipboard.invalidate();
+        }
     }
 
     std::string_view get_clipboard_string()
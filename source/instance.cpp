@@ -1,12 +1,21 @@
 #include "glfw_cpp/instance.hpp"
+#include "glfw_cpp/extension_set.hpp"
+#include "glfw_cpp/proc_table.hpp"
+#include "glfw_cpp/trace.hpp"
 #include "glfw_cpp/window.hpp"
 
+#include "probe.hpp"
 #include "util.hpp"
 
 #define GLFW_INCLUDE_NONE
 #include <GLFW/glfw3.h>
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <cstdint>
+#include <iterator>
+#include <ranges>
 #include <thread>
 #include <utility>
 
@@ -18,6 +27,68 @@
 
 namespace
 {
+    // bumped on init and termination so that caches of every thread are invalidated at once
+    std::atomic<std::uint64_t> g_context_epoch = 1;
+
+    struct ContextCache
+    {
+        GLFWwindow*                  current = nullptr;
+        std::uint64_t                epoch   = 0;    // the cache is valid only if it equals g_context_epoch
+        glfw_cpp::ContextSwitchStats stats   = {};
+
+        bool valid() const noexcept { return epoch == g_context_epoch.load(std::memory_order::relaxed); }
+    };
+
+    thread_local ContextCache t_context_cache = {};
+
+    // returns false if glfwMakeContextCurrent was skipped, otherwise the caller checks the error and stores
+    bool switch_current(GLFWwindow* window) noexcept
+    {
+        auto& cache = t_context_cache;
+
+        // emscripten-glfw emits an error if window is nullptr before 3.4.0.20251217,
+        // see: https://github.com/pongasoft/emscripten-glfw/issues/24
+
+        // clang-format off: I want to preserve the digit separator as is
+#if __EMSCRIPTEN__ and EMSCRIPTEN_GLFW_VERSION < 3'4'0'20251217
+        // clang-format on
+
+        if (window == nullptr) {
+            cache.epoch = 0;
+            return false;
+        }
+#endif
+
+        if (cache.valid() and cache.current == window) {
+            ++cache.stats.avoided;
+            return false;
+        }
+
+        ++cache.stats.switches;
+        cache.epoch = 0;    // in case of error the current context is unknown
+
+        glfwMakeContextCurrent(window);
+        return true;
+    }
+
+    std::optional<GLFWwindow*> cached_current() noexcept
+    {
+        auto& cache = t_context_cache;
+        if (cache.valid()) {
+            ++cache.stats.cached_queries;
+            return cache.current;
+        }
+
+        ++cache.stats.queries;
+        return std::nullopt;
+    }
+
+    void store_current(GLFWwindow* window) noexcept
+    {
+        t_context_cache.current = window;
+        t_context_cache.epoch   = g_context_epoch.load(std::memory_order::relaxed);
+    }
+
     template <bool Opt, typename A>
     void apply_hints_impl(const glfw_cpp::Hints<Opt>& hints, A adapter)
     {
@@ -176,6 +247,7 @@ namespace glfw_cpp
         {
             if (auto* ptr = glfwGetWindowUserPointer(window); ptr != nullptr) {
                 auto& window = *static_cast<Window*>(ptr);
+                Instance::get().m_windows.mark_closed(window.id());
                 Instance::get().push_event(window, event::WindowClosed{});
             }
         }
@@ -192,6 +264,13 @@ namespace glfw_cpp
         {
             if (auto* ptr = glfwGetWindowUserPointer(window); ptr != nullptr) {
                 auto& window = *static_cast<Window*>(ptr);
+
+                // another application may have set the clipboard while our windows were unfocused; it can
+                // also change while they are focused, so the cache expires as well (see Clipboard)
+                if (focused == GLFW_TRUE) {
+                    Instance::get().m_clipboard.invalidate();
+                }
+
                 Instance::get().push_event(
                     window,
                     event::WindowFocused{
@@ -385,12 +464,15 @@ namespace glfw_cpp
         // flush task queue first (there might be window deletion request)
         run_tasks();
 
-        for (auto handle : m_windows) {
+        m_windows.for_each([](GLFWwindow* handle) {
+            gl::forget_extensions(handle);
             glfwDestroyWindow(handle);
-        }
+        });
 
         // this might fail, how should I report the failure?
         glfwTerminate();
+        g_context_epoch.fetch_add(1, std::memory_order::relaxed);
+        gl::clear_proc_table_cache();
 
         Instance::s_instance = nullptr;
         glfwSetErrorCallback(nullptr);
@@ -404,10 +486,14 @@ namespace glfw_cpp
 
     void Instance::push_event(Window& window, Event event) noexcept
     {
+        auto span    = trace::Span{ "Instance::push_event" };
         auto forward = true;
 
+        GLFW_CPP_PROBE(event_push, window.handle(), event.variant.index());
+
         if (m_event_interceptor) {
-            auto& intr = *m_event_interceptor;
+            auto  intercept_span = trace::Span{ "EventInterceptor" };
+            auto& intr           = *m_event_interceptor;
 
             forward = event.visit(event::Overload{
                 // clang-format off
@@ -433,6 +519,8 @@ namespace glfw_cpp
 
         if (forward) {
             window.push_event(std::move(event));
+        } else {
+            GLFW_CPP_PROBE(event_intercepted, window.handle(), event.variant.index());
         }
     }
 
@@ -455,22 +543,58 @@ namespace glfw_cpp
 
     void Instance::run_tasks()
     {
+        auto span = trace::Span{ "Instance::run_tasks" };
+
+        using Clock = std::chrono::steady_clock;
+        [[maybe_unused]] auto start = probe::enabled ? Clock::now() : Clock::time_point{};
+
+        // the queue is swapped with the one of the previous call, so that a steady flow of tasks doesn't
+        // allocate the queue again on every call
         auto [deletion, tasks] = [&] {
             auto lock = std::scoped_lock{ m_mutex };
-            return std::pair{ std::exchange(m_window_delete_queue, {}), std::exchange(m_task_queue, {}) };
+            return std::pair{
+                std::exchange(m_window_delete_queue, {}),
+                std::exchange(m_task_queue, std::move(m_task_queue_spare)),
+            };
         }();
 
         for (auto&& task : tasks) {
             task();
         }
 
+        [[maybe_unused]] auto task_count = tasks.size();
+        tasks.clear();
+        m_task_queue_spare = std::move(tasks);
+
         // window deletion
-        for (auto handle : deletion) {
-            if (std::erase(m_windows, handle) != 0) {
+        auto deletion_span = trace::Span{ "window destruction" };
+        for (auto id : deletion) {
+            if (auto handle = m_windows.erase(id); handle != nullptr) {
+                // glfwDestroyWindow detaches the context, and the handle may be handed out again for another
+                // window; the caches of every thread that may hold it are dropped
+                g_context_epoch.fetch_add(1, std::memory_order::relaxed);
+                gl::forget_extensions(handle);
                 glfwDestroyWindow(handle);
                 util::check_glfw_error();
             }
         }
+
+        GLFW_CPP_PROBE(
+            run_tasks, task_count, deletion.size(), std::chrono::nanoseconds{ Clock::now() - start }.count()
+        );
+    }
+
+    Result<void> Instance::run_tasks_noexcept() noexcept
+    {
+        // the tasks are arbitrary functions, so this is the only place the exceptions can be caught
+        try {
+            run_tasks();
+        } catch (const error::Error& e) {
+            return Unexpected{ e.code() };
+        } catch (...) {
+            return Unexpected{ ErrorCode::UnknownError };
+        }
+        return {};
     }
 
     void Instance::apply_hints(const PartialHints& hints)
@@ -528,9 +652,28 @@ namespace glfw_cpp
 
         const auto handle = glfwCreateWindow(width, height, title.data(), monitor, share);
         if (handle == nullptr) {
+            const char* description = nullptr;
+            const int   code        = glfwGetError(&description);
+
+            // the creation error is thrown here, so it's not queued twice; older errors stay queued
+            if constexpr (error_policy == ErrorPolicy::Deferred) {
+                auto is_creation_error = [&](const std::pair<int, std::string>& err) {
+                    return err.first == code and description != nullptr and err.second == description;
+                };
+
+                auto lock  = std::scoped_lock{ m_error_mutex };
+                auto found = std::ranges::find_if(m_deferred_errors | std::views::reverse, is_creation_error);
+                if (found != m_deferred_errors.rend()) {
+                    m_deferred_errors.erase(std::next(found).base());
+                }
+            }
+
+            if (code != GLFW_NO_ERROR) {
+                util::throw_error(code, description);
+            }
             util::throw_glfw_error();
         }
-        m_windows.emplace_back(handle);
+        auto id = m_windows.insert(handle);
 
         glfwSetWindowPosCallback(handle, CallbackHandler::window_pos);
         glfwSetWindowSizeCallback(handle, CallbackHandler::window_size);
@@ -551,9 +694,11 @@ namespace glfw_cpp
 
         int    real_width, real_height, fb_width, fb_height;
         double x_cursor, y_cursor;
+        float  x_scale, y_scale;
         glfwGetWindowSize(handle, &real_width, &real_height);
         glfwGetCursorPos(handle, &x_cursor, &y_cursor);
         glfwGetFramebufferSize(handle, &fb_width, &fb_height);
+        glfwGetWindowContentScale(handle, &x_scale, &y_scale);
 
         int x_pos = 0, y_pos = 0;
         if (platform() != hint::Platform::Wayland) {    // emits GLFW_FEATURE_UNAVAILABLE on wayland
@@ -567,6 +712,7 @@ namespace glfw_cpp
             .position           = { x_pos, y_pos },
             .dimensions         = { real_width, real_height },
             .framebuffer_size   = { fb_width, fb_height },
+            .content_scale      = { x_scale, y_scale },
             .cursor_position    = { x_cursor, y_cursor },
             .mouse_button_state = {},
             .key_state          = {},
@@ -603,12 +749,12 @@ namespace glfw_cpp
         }
 #endif
 
-        return Window{ handle, std::move(properties), std::move(attributes) };
+        return Window{ handle, id, std::move(properties), std::move(attributes) };
     }
 
     bool Instance::has_window_opened() const noexcept
     {
-        return std::ranges::any_of(m_windows, [](auto* h) { return glfwWindowShouldClose(h) != GLFW_TRUE; });
+        return m_windows.open_count() != 0;
     }
 
     void Instance::poll_events(std::optional<std::chrono::milliseconds> poll_rate)
@@ -618,17 +764,25 @@ namespace glfw_cpp
         if (poll_rate) {
             auto sleep_until_time = std::chrono::steady_clock::now() + *poll_rate;
 
-            glfwPollEvents();
+            {
+                auto poll_span = trace::Span{ "glfwPollEvents" };
+                glfwPollEvents();
+            }
             util::check_glfw_error();
             run_tasks();
+            rethrow_deferred_errors();
 
             if (sleep_until_time > std::chrono::steady_clock::now()) {
                 std::this_thread::sleep_until(sleep_until_time);
             }
         } else {
-            glfwPollEvents();
+            {
+                auto poll_span = trace::Span{ "glfwPollEvents" };
+                glfwPollEvents();
+            }
             util::check_glfw_error();
             run_tasks();
+            rethrow_deferred_errors();
         }
     }
 
@@ -638,27 +792,161 @@ namespace glfw_cpp
         if (timeout) {
             using SecondsDouble = std::chrono::duration<double>;
             const auto seconds  = std::chrono::duration_cast<SecondsDouble>(*timeout);
-            glfwWaitEventsTimeout(seconds.count());
+            {
+                auto wait_span = trace::Span{ "glfwWaitEvents" };
+                glfwWaitEventsTimeout(seconds.count());
+            }
             util::check_glfw_error();
         } else {
-            glfwWaitEvents();
+            {
+                auto wait_span = trace::Span{ "glfwWaitEvents" };
+                glfwWaitEvents();
+            }
             util::check_glfw_error();
         }
         run_tasks();
+        rethrow_deferred_errors();
+    }
+
+    Result<void> Instance::poll_events_noexcept(std::optional<std::chrono::milliseconds> poll_rate) noexcept
+    {
+        if (m_attached_thread_id != std::this_thread::get_id()) {
+            return Unexpected{ ErrorCode::WrongThreadAccess };
+        }
+
+        auto poll_period      = poll_rate.value_or(std::chrono::milliseconds{});
+        auto sleep_until_time = std::chrono::steady_clock::now() + poll_period;
+
+        {
+            auto poll_span = trace::Span{ "glfwPollEvents" };
+            glfwPollEvents();
+        }
+        if (auto res = util::check_glfw_error_noexcept(); not res) {
+            return res;
+        }
+        if (auto res = run_tasks_noexcept(); not res) {
+            return res;
+        }
+        if (auto res = take_deferred_errors(); not res) {
+            return res;
+        }
+
+        if (poll_rate and sleep_until_time > std::chrono::steady_clock::now()) {
+            std::this_thread::sleep_until(sleep_until_time);
+        }
+
+        return {};
     }
 
-    void Instance::request_delete_window(GLFWwindow* handle) noexcept
+    Result<void> Instance::wait_events_noexcept(std::optional<std::chrono::milliseconds> timeout) noexcept
+    {
+        if (m_attached_thread_id != std::this_thread::get_id()) {
+            return Unexpected{ ErrorCode::WrongThreadAccess };
+        }
+
+        if (auto wait_span = trace::Span{ "glfwWaitEvents" }; timeout) {
+            using SecondsDouble = std::chrono::duration<double>;
+            const auto seconds  = std::chrono::duration_cast<SecondsDouble>(*timeout);
+            glfwWaitEventsTimeout(seconds.count());
+        } else {
+            glfwWaitEvents();
+        }
+
+        if (auto res = util::check_glfw_error_noexcept(); not res) {
+            return res;
+        }
+        if (auto res = run_tasks_noexcept(); not res) {
+            return res;
+        }
+        return take_deferred_errors();
+    }
+
+    void Instance::request_delete_window(WindowId id) noexcept
     {
         auto lock = std::unique_lock{ m_mutex };
-        m_window_delete_queue.push_back(handle);
+        m_window_delete_queue.push_back(id);
+    }
+
+    void Instance::rethrow_deferred_errors()
+    {
+        if constexpr (error_policy == ErrorPolicy::Deferred) {
+            auto errors = util::lock_exchange(m_error_mutex, m_deferred_errors, {});
+            if (errors.empty()) {
+                return;
+            }
+
+            auto& [code, description] = errors.front();
+            if (errors.size() > 1) {
+                description += std::format(" (and {} more error(s))", errors.size() - 1);
+            }
+            util::throw_error(code, description.c_str());
+        }
+    }
+
+    Result<void> Instance::take_deferred_errors() noexcept
+    {
+        if constexpr (error_policy == ErrorPolicy::Deferred) {
+            auto errors = util::lock_exchange(m_error_mutex, m_deferred_errors, {});
+            if (not errors.empty()) {
+                return Unexpected{ static_cast<ErrorCode>(errors.front().first) };
+            }
+        }
+        return {};
     }
 
     void Instance::enqueue_task(std::function<void()>&& task) noexcept
+    {
+        push_task(std::move(task));
+    }
+
+    void Instance::push_task(task::Function&& task) noexcept
     {
         auto lock = std::unique_lock{ m_mutex };
         m_task_queue.emplace_back(std::move(task));
     }
 
+    task::LatencyStats Instance::main_thread_latency() const noexcept
+    {
+        using Ns = std::chrono::nanoseconds;
+
+        auto count = m_latency_count.load(std::memory_order::relaxed);
+        auto total = m_latency_total.load(std::memory_order::relaxed);
+
+        return {
+            .count = static_cast<std::size_t>(count),
+            .last  = Ns{ m_latency_last.load(std::memory_order::relaxed) },
+            .max   = Ns{ m_latency_max.load(std::memory_order::relaxed) },
+            .mean  = Ns{ count != 0 ? total / count : 0 },
+        };
+    }
+
+    void Instance::reset_main_thread_latency() noexcept
+    {
+        m_latency_count.store(0, std::memory_order::relaxed);
+        m_latency_total.store(0, std::memory_order::relaxed);
+        m_latency_last.store(0, std::memory_order::relaxed);
+        m_latency_max.store(0, std::memory_order::relaxed);
+    }
+
+    void Instance::wake_main_thread() noexcept
+    {
+        glfwPostEmptyEvent();
+    }
+
+    void Instance::record_latency(std::chrono::nanoseconds latency) noexcept
+    {
+        auto ns = static_cast<std::uint64_t>(latency.count());
+
+        m_latency_count.fetch_add(1, std::memory_order::relaxed);
+        m_latency_total.fetch_add(ns, std::memory_order::relaxed);
+        m_latency_last.store(ns, std::memory_order::relaxed);
+
+        auto max = m_latency_max.load(std::memory_order::relaxed);
+        while (ns > max and not m_latency_max.compare_exchange_weak(max, ns, std::memory_order::relaxed)) {
+            // max is reloaded by the failed exchange
+        }
+    }
+
     hint::Platform Instance::platform() const noexcept
     {
         auto platform = glfwGetPlatform();
@@ -687,14 +975,25 @@ namespace glfw_cpp
 
     bool extension_supported(const char* extension)
     {
-        auto res = glfwExtensionSupported(extension) == GLFW_TRUE;
-        util::check_glfw_error();
-        return res;
+        if (extension == nullptr or *extension == '\0') {
+            throw error::InvalidValue{ "Extension name must not be empty" };
+        }
+        return gl::current_extensions().contains(extension);
     }
 
     bool extension_supported_noexcept(const char* extension) noexcept
     {
-        return glfwExtensionSupported(extension) == GLFW_TRUE;
+        // invalid calls are left to GLFW, which reports the error through the error callback
+        if (extension == nullptr or *extension == '\0' or glfwGetCurrentContext() == nullptr) {
+            return glfwExtensionSupported(extension) == GLFW_TRUE;
+        }
+
+        // same lookup as extension_supported(); an error was already reported by the call that failed
+        try {
+            return gl::current_extensions().contains(extension);
+        } catch (...) {
+            return false;
+        }
     }
 
     Instance::Unique init(const InitHints& hints)
@@ -714,6 +1013,10 @@ namespace glfw_cpp
             if (instance.m_callback) {
                 instance.m_callback(static_cast<ErrorCode>(err), msg);
             }
+            if constexpr (error_policy == ErrorPolicy::Deferred) {
+                std::scoped_lock lock{ instance.m_error_mutex };
+                instance.m_deferred_errors.emplace_back(err, msg);
+            }
         });
 
         glfwInitHint(GLFW_PLATFORM, static_cast<int>(hints.platform));
@@ -735,31 +1038,71 @@ namespace glfw_cpp
         glfwSetMonitorCallback(Instance::CallbackHandler::monitor);
         util::check_glfw_error();
 
+        g_context_epoch.fetch_add(1, std::memory_order::relaxed);
+
         return instance;
     }
 
     void make_current(GLFWwindow* window)
     {
-        // emscripten-glfw emits an error if window is nullptr before 3.4.0.20251217,
-        // see: https://github.com/pongasoft/emscripten-glfw/issues/24
+        if (switch_current(window)) {
+            util::check_glfw_error();
+            store_current(window);
+        }
+    }
 
-        // clang-format off: I want to preserve the digit separator as is
-#if __EMSCRIPTEN__ and EMSCRIPTEN_GLFW_VERSION < 3'4'0'20251217
-        // clang-format on
+    Result<void> make_current_noexcept(GLFWwindow* window) noexcept
+    {
+        if (switch_current(window)) {
+            if (auto res = util::check_glfw_error_noexcept(); not res) {
+                return res;
+            }
+            store_current(window);
+        }
+        return {};
+    }
 
-        if (window == nullptr) {
-            return;
+    GLFWwindow* get_current()
+    {
+        if (auto cached = cached_current(); cached.has_value()) {
+            return *cached;
         }
-#endif
 
-        glfwMakeContextCurrent(window);
+        auto current = glfwGetCurrentContext();
         util::check_glfw_error();
+
+        store_current(current);
+        return current;
     }
 
-    GLFWwindow* get_current()
+    Result<GLFWwindow*> get_current_noexcept() noexcept
     {
+        if (auto cached = cached_current(); cached.has_value()) {
+            return *cached;
+        }
+
         auto current = glfwGetCurrentContext();
-        util::check_glfw_error();
+        if (auto res = util::check_glfw_error_noexcept(); not res) {
+            return Unexpected{ res.error() };
+        }
+
+        store_current(current);
         return current;
     }
+
+    void invalidate_current_cache() noexcept
+    {
+        t_context_cache.current = nullptr;
+        t_context_cache.epoch   = 0;
+    }
+
+    ContextSwitchStats context_switch_stats() noexcept
+    {
+        return t_context_cache.stats;
+    }
+
+    void reset_context_switch_stats() noexcept
+    {
+        t_context_cache.stats = {};
+    }
 }
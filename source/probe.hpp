@@ -0,0 +1,40 @@
+#ifndef PROBE_HPP_Q7K2M9XD4TLA
+#define PROBE_HPP_Q7K2M9XD4TLA
+
+// USDT (userland statically defined tracing) probes under the `glfw_cpp` provider, enabled with the CMake
+// option `GLFW_CPP_ENABLE_USDT` on Linux with <sys/sdt.h> available (systemtap-sdt-dev or -devel package).
+//
+// An enabled probe is a single nop plus an ELF note until a tracer attaches to it, e.g.
+//     bpftrace -e 'usdt:./app:glfw_cpp:swap_buffers_entry { @[tid] = nsecs; }'
+// see `example/bpftrace` for the scripts. When disabled the macro expands to nothing and its arguments are
+// not evaluated.
+//
+// probe                                     arguments
+// ---------------------------------------------------------------------------------------------------
+// glfw_cpp:event_push                       window handle, event type (index in `event::Variant`)
+// glfw_cpp:event_intercepted                window handle, event type (dropped by the interceptor)
+// glfw_cpp:queue_overflow                   window handle, dropped event type, queue capacity
+// glfw_cpp:run_tasks                        task count, window destruction count, duration in ns
+// glfw_cpp:swap_events                      window handle, number of events swapped in
+// glfw_cpp:swap_buffers_entry               window handle
+// glfw_cpp:swap_buffers_return              window handle
+
+#if defined(GLFW_CPP_ENABLE_USDT) and __has_include(<sys/sdt.h>)
+    #include <sys/sdt.h>
+
+    #define GLFW_CPP_PROBE(name, ...) STAP_PROBEV(glfw_cpp, name __VA_OPT__(, ) __VA_ARGS__)
+
+namespace probe
+{
+    inline constexpr bool enabled = true;
+}
+#else
+    #define GLFW_CPP_PROBE(name, ...) static_cast<void>(0)
+
+namespace probe
+{
+    inline constexpr bool enabled = false;
+}
+#endif
+
+#endif /* end of include guard: PROBE_HPP_Q7K2M9XD4TLA */
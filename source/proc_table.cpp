@@ -0,0 +1,151 @@
+#include "glfw_cpp/proc_table.hpp"
+
+#include "util.hpp"
+
+#define GLFW_INCLUDE_NONE
+#include <GLFW/glfw3.h>
+
+#include <algorithm>
+#include <charconv>
+#include <mutex>
+#include <string_view>
+#include <utility>
+
+#if defined(_WIN32)
+    #define GLFW_CPP_GL_APIENTRY __stdcall
+#else
+    #define GLFW_CPP_GL_APIENTRY
+#endif
+
+namespace
+{
+    using GetStringFn   = const unsigned char*(GLFW_CPP_GL_APIENTRY*)(unsigned int);
+    using GetIntegervFn = void(GLFW_CPP_GL_APIENTRY*)(unsigned int, int*);
+
+    constexpr unsigned int GL_VENDOR               = 0x1F00;
+    constexpr unsigned int GL_RENDERER             = 0x1F01;
+    constexpr unsigned int GL_VERSION              = 0x1F02;
+    constexpr unsigned int GL_CONTEXT_PROFILE_MASK = 0x9126;
+
+    struct CacheEntry
+    {
+        const char* const*                             names;
+        std::size_t                                    size;
+        std::shared_ptr<const glfw_cpp::gl::ProcTable> table;
+    };
+
+    std::mutex              g_cache_mutex;
+    std::vector<CacheEntry> g_cache;    // protected by g_cache_mutex
+
+    std::string gl_string(const unsigned char* str)
+    {
+        return str != nullptr ? reinterpret_cast<const char*>(str) : "";
+    }
+
+    // the profile mask is only queryable on desktop OpenGL 3.2 and later, querying it elsewhere is a GL error
+    bool has_profile_mask(std::string_view version) noexcept
+    {
+        if (version.starts_with("OpenGL ES")) {
+            return false;
+        }
+
+        auto major = 0;
+        auto minor = 0;
+
+        auto [ptr, ec] = std::from_chars(version.data(), version.data() + version.size(), major);
+        if (ec != std::errc{} or ptr == version.data() + version.size() or *ptr != '.') {
+            return false;
+        }
+        std::from_chars(ptr + 1, version.data() + version.size(), minor);
+
+        return major > 3 or (major == 3 and minor >= 2);
+    }
+}
+
+namespace glfw_cpp::gl
+{
+    ProcTable::ProcTable(ContextSignature signature, std::span<const char* const> names, GetProc* loader)
+        : m_signature{ std::move(signature) }
+        , m_names{ names }
+    {
+        m_procs.reserve(names.size());
+        if (loader != nullptr) {
+            for (auto name : names) {
+                m_procs.push_back(loader(name));
+            }
+        } else {
+            for (auto name : names) {
+                m_procs.push_back(glfwGetProcAddress(name));
+            }
+            util::check_glfw_error();
+        }
+
+        m_missing = static_cast<std::size_t>(std::ranges::count(m_procs, nullptr));
+    }
+
+    ContextSignature current_context_signature()
+    {
+        auto get_string   = reinterpret_cast<GetStringFn>(glfwGetProcAddress("glGetString"));
+        auto get_integerv = reinterpret_cast<GetIntegervFn>(glfwGetProcAddress("glGetIntegerv"));
+        util::check_glfw_error();
+
+        // with the non-immediate error policies the check above doesn't throw
+        if (get_string == nullptr or get_integerv == nullptr) {
+            throw error::NoCurrentContext{ "Can't query the signature without a current context" };
+        }
+
+        auto signature = ContextSignature{
+            .vendor   = gl_string(get_string(GL_VENDOR)),
+            .renderer = gl_string(get_string(GL_RENDERER)),
+            .version  = gl_string(get_string(GL_VERSION)),
+        };
+
+        if (has_profile_mask(signature.version)) {
+            get_integerv(GL_CONTEXT_PROFILE_MASK, &signature.profile_mask);
+        }
+
+        return signature;
+    }
+
+    std::shared_ptr<const ProcTable> load_proc_table(std::span<const char* const> names)
+    {
+        return load_proc_table(names, current_context_signature(), nullptr);
+    }
+
+    std::shared_ptr<const ProcTable> load_proc_table(
+        std::span<const char* const> names,
+        const ContextSignature&      signature,
+        GetProc*                     loader
+    )
+    {
+        auto matches = [&](const CacheEntry& entry) {
+            return entry.names == names.data() and entry.size == names.size()
+               and entry.table->signature() == signature;
+        };
+
+        {
+            std::scoped_lock lock{ g_cache_mutex };
+            if (auto found = std::ranges::find_if(g_cache, matches); found != g_cache.end()) {
+                return found->table;
+            }
+        }
+
+        // resolved outside the lock; if another thread raced us, the first table stored wins (the table
+        // copies the signature, `matches` still compares against it)
+        auto table = std::make_shared<const ProcTable>(signature, names, loader);
+
+        std::scoped_lock lock{ g_cache_mutex };
+        if (auto found = std::ranges::find_if(g_cache, matches); found != g_cache.end()) {
+            return found->table;
+        }
+
+        g_cache.push_back({ .names = names.data(), .size = names.size(), .table = table });
+        return table;
+    }
+
+    void clear_proc_table_cache() noexcept
+    {
+        std::scoped_lock lock{ g_cache_mutex };
+        g_cache.clear();
+    }
+}
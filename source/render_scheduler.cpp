@@ -0,0 +1,344 @@
+#include "glfw_cpp/render_scheduler.hpp"
+#include "glfw_cpp/instance.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+
+namespace
+{
+    using Clock = glfw_cpp::RenderScheduler::Clock;
+
+    std::optional<Clock::duration> to_period(std::optional<double> rate) noexcept
+    {
+        if (not rate.has_value()) {
+            return std::nullopt;
+        }
+
+        assert(*rate > 0.0);
+        auto period = std::chrono::duration<double>{ 1.0 / *rate };
+        return std::chrono::duration_cast<Clock::duration>(period);
+    }
+
+    // std::push_heap and std::pop_heap build a max-heap, the comparison is inverted to get a min-heap
+    template <typename Job>
+    bool later(const Job* lhs, const Job* rhs) noexcept
+    {
+        return lhs->deadline > rhs->deadline;
+    }
+}
+
+namespace glfw_cpp
+{
+    RenderScheduler::RenderScheduler(std::size_t thread_count)
+    {
+        if (thread_count == 0) {
+            thread_count = std::max(std::thread::hardware_concurrency(), 1u);
+        }
+
+        m_workers.reserve(thread_count);
+        for (auto i = 0u; i < thread_count; ++i) {
+            m_workers.push_back(std::make_unique<Worker>());
+        }
+
+        m_threads.reserve(thread_count);
+        for (auto i = 0u; i < thread_count; ++i) {
+            m_threads.emplace_back([this, i](std::stop_token stop) { work(stop, i); });
+        }
+    }
+
+    RenderScheduler::~RenderScheduler()
+    {
+        for (auto& thread : m_threads) {
+            thread.request_stop();
+        }
+        m_threads.clear();
+    }
+
+    void RenderScheduler::add(Window& window, Render render, std::optional<double> target_rate)
+    {
+        if (window.has_context()) {
+            window.set_vsync(false);
+        }
+
+        auto job = std::make_unique<Job>(Job{
+            .window   = &window,
+            .render   = std::move(render),
+            .period   = to_period(target_rate),
+            .deadline = Clock::now(),
+        });
+
+        {
+            std::scoped_lock lock{ m_mutex };
+
+            // a job is either running, parked, or in a single ring, so room for every job is always enough
+            auto capacity = m_jobs.size() + 1;
+            m_jobs.reserve(capacity);
+            m_parked.reserve(capacity);
+            for (auto& worker : m_workers) {
+                std::scoped_lock worker_lock{ worker->mutex };
+                worker->reserve(capacity);
+            }
+
+            m_parked.push_back(job.get());
+            std::ranges::push_heap(m_parked, later<Job>);
+            m_jobs.push_back(std::move(job));
+        }
+        m_cv.notify_one();
+    }
+
+    std::size_t RenderScheduler::active() const
+    {
+        std::scoped_lock lock{ m_mutex };
+        if (m_exception) {
+            std::rethrow_exception(std::exchange(m_exception, nullptr));
+        }
+        return m_jobs.size();
+    }
+
+    void RenderScheduler::wait() const
+    {
+        std::unique_lock lock{ m_mutex };
+        m_cv.wait(lock, [&] { return m_jobs.empty() or m_exception; });
+        if (m_exception) {
+            std::rethrow_exception(std::exchange(m_exception, nullptr));
+        }
+    }
+
+    RenderScheduler::Stats RenderScheduler::stats() const noexcept
+    {
+        return {
+            .frames = m_frames.load(std::memory_order::relaxed),
+            .steals = m_steals.load(std::memory_order::relaxed),
+            .missed = m_missed.load(std::memory_order::relaxed),
+        };
+    }
+
+    void RenderScheduler::work(std::stop_token stop, std::size_t index) noexcept
+    {
+        while (not stop.stop_requested()) {
+            release_due(index);
+
+            if (auto* job = pop(index); job != nullptr) {
+                run_frame(*job, index);
+                continue;
+            }
+
+            if (auto* job = steal(index); job != nullptr) {
+                run_frame(*job, index);
+                continue;
+            }
+
+            std::unique_lock lock{ m_mutex };
+            auto ready = [&] {
+                auto due = not m_parked.empty() and m_parked.front()->deadline <= Clock::now();
+                return due or m_ready.load(std::memory_order::acquire) > 0;
+            };
+
+            if (m_parked.empty()) {
+                m_cv.wait(lock, stop, ready);
+            } else {
+                auto nearest = m_parked.front()->deadline;    // copied, the job may be retired while waiting
+                m_cv.wait_until(lock, stop, nearest, ready);
+            }
+        }
+    }
+
+    void RenderScheduler::run_frame(Job& job, std::size_t index) noexcept
+    {
+        auto& window  = *job.window;
+        auto  context = window.has_context();
+        auto  now     = Clock::now();
+
+        if (job.period.has_value() and now > job.deadline + *job.period) {
+            m_missed.fetch_add(1, std::memory_order::relaxed);
+        }
+
+        if (window.should_close()) {
+            retire(job, nullptr);
+            return;
+        }
+
+        try {
+            if (context) {
+                glfw_cpp::make_current(window.handle());
+            }
+
+            const auto& events = window.swap_events();
+            job.render(window, events);
+
+            if (context) {
+                window.swap_buffers();
+                glfw_cpp::make_current(nullptr);
+            }
+        } catch (...) {
+            auto exception = std::current_exception();
+            try {
+                if (context) {
+                    glfw_cpp::make_current(nullptr);
+                }
+            } catch (...) {
+                // the first exception is the one worth reporting
+            }
+            retire(job, exception);
+            return;
+        }
+
+        m_frames.fetch_add(1, std::memory_order::relaxed);
+
+        if (not job.period.has_value()) {
+            push(index, job);
+            return;
+        }
+
+        // keep the cadence unless the window fell behind by more than a period
+        job.deadline += *job.period;
+        if (job.deadline < now) {
+            job.deadline = now + *job.period;
+        }
+
+        park(job);
+    }
+
+    void RenderScheduler::retire(Job& job, std::exception_ptr exception) noexcept
+    {
+        {
+            std::scoped_lock lock{ m_mutex };
+            if (exception and not m_exception) {
+                m_exception = exception;
+            }
+            std::erase_if(m_jobs, [&](const auto& ptr) { return ptr.get() == &job; });
+        }
+        m_cv.notify_all();
+    }
+
+    void RenderScheduler::park(Job& job) noexcept
+    {
+        {
+            std::scoped_lock lock{ m_mutex };
+            m_parked.push_back(&job);
+            std::ranges::push_heap(m_parked, later<Job>);
+        }
+        m_cv.notify_one();    // the new job may be due earlier than what the sleeping workers wait for
+    }
+
+    void RenderScheduler::push(std::size_t index, Job& job) noexcept
+    {
+        {
+            // counted with the push, a thief popping the job right after the unlock never decrements first
+            auto& worker = *m_workers[index];
+            std::scoped_lock lock{ worker.mutex };
+            worker.push_back(&job);
+            m_ready.fetch_add(1, std::memory_order::release);
+        }
+
+        // the empty critical section orders the increment with the predicate check of sleeping workers
+        {
+            std::scoped_lock lock{ m_mutex };
+        }
+        m_cv.notify_one();
+    }
+
+    void RenderScheduler::release_due(std::size_t index) noexcept
+    {
+        auto released = 0u;
+        {
+            std::scoped_lock lock{ m_mutex };
+            auto now = Clock::now();
+            if (m_parked.empty() or m_parked.front()->deadline > now) {
+                return;
+            }
+
+            auto& worker = *m_workers[index];
+            std::scoped_lock worker_lock{ worker.mutex };
+            while (not m_parked.empty() and m_parked.front()->deadline <= now) {
+                std::ranges::pop_heap(m_parked, later<Job>);
+                worker.push_back(m_parked.back());
+                m_parked.pop_back();
+                ++released;
+            }
+
+            // counted under m_mutex, so a worker checking the predicate before going to sleep sees it
+            m_ready.fetch_add(released, std::memory_order::release);
+        }
+
+        for (auto i = 0u; i < released; ++i) {
+            m_cv.notify_one();
+        }
+    }
+
+    RenderScheduler::Job* RenderScheduler::pop(std::size_t index) noexcept
+    {
+        auto& worker = *m_workers[index];
+        std::scoped_lock lock{ worker.mutex };
+
+        auto* job = worker.pop_front();
+        if (job != nullptr) {
+            m_ready.fetch_sub(1, std::memory_order::relaxed);
+        }
+        return job;
+    }
+
+    RenderScheduler::Job* RenderScheduler::steal(std::size_t index) noexcept
+    {
+        for (auto offset = 1u; offset < m_workers.size(); ++offset) {
+            auto& victim = *m_workers[(index + offset) % m_workers.size()];
+            std::scoped_lock lock{ victim.mutex };
+
+            auto* job = victim.pop_back();
+            if (job == nullptr) {
+                continue;
+            }
+
+            m_ready.fetch_sub(1, std::memory_order::relaxed);
+            m_steals.fetch_add(1, std::memory_order::relaxed);
+            return job;
+        }
+
+        return nullptr;
+    }
+
+    void RenderScheduler::Worker::reserve(std::size_t capacity)
+    {
+        if (capacity <= ring.size()) {
+            return;
+        }
+
+        auto grown = std::vector<Job*>(capacity);
+        for (auto i = std::size_t{ 0 }; i < count; ++i) {
+            grown[i] = ring[(head + i) % ring.size()];
+        }
+
+        ring = std::move(grown);
+        head = 0;
+    }
+
+    void RenderScheduler::Worker::push_back(Job* job) noexcept
+    {
+        assert(count < ring.size());
+        ring[(head + count) % ring.size()] = job;
+        ++count;
+    }
+
+    RenderScheduler::Job* RenderScheduler::Worker::pop_front() noexcept
+    {
+        if (count == 0) {
+            return nullptr;
+        }
+
+        auto* job = ring[head];
+        head      = (head + 1) % ring.size();
+        --count;
+        return job;
+    }
+
+    RenderScheduler::Job* RenderScheduler::Worker::pop_back() noexcept
+    {
+        if (count == 0) {
+            return nullptr;
+        }
+
+        --count;
+        return ring[(head + count) % ring.size()];
+    }
+}
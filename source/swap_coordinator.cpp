@@ -0,0 +1,102 @@
+#include "glfw_cpp/swap_coordinator.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <thread>
+
+namespace
+{
+    using Clock = glfw_cpp::SwapCoordinator::Clock;
+
+    std::optional<Clock::duration> to_period(std::optional<double> rate) noexcept
+    {
+        if (not rate.has_value()) {
+            return std::nullopt;
+        }
+
+        assert(*rate > 0.0);
+        auto period = std::chrono::duration<double>{ 1.0 / *rate };
+        return std::chrono::duration_cast<Clock::duration>(period);
+    }
+}
+
+namespace glfw_cpp
+{
+    void SwapCoordinator::add(Window& window, std::optional<double> target_rate)
+    {
+        auto found = std::ranges::find(m_entries, &window, &Entry::window);
+        if (found != m_entries.end()) {
+            found->period = to_period(target_rate);
+            return;
+        }
+
+        m_entries.push_back({
+            .window   = &window,
+            .period   = to_period(target_rate),
+            .deadline = Clock::now(),
+        });
+    }
+
+    void SwapCoordinator::remove(const Window& window) noexcept
+    {
+        std::erase_if(m_entries, [&](const Entry& entry) { return entry.window == &window; });
+    }
+
+    void SwapCoordinator::set_target_rate(const Window& window, std::optional<double> target_rate) noexcept
+    {
+        auto found = std::ranges::find(m_entries, &window, &Entry::window);
+        if (found != m_entries.end()) {
+            found->period   = to_period(target_rate);
+            found->deadline = Clock::now();
+        }
+    }
+
+    const std::vector<Window*>& SwapCoordinator::schedule()
+    {
+        m_due.clear();
+        m_display_rate.clear();
+
+        while (true) {
+            auto now     = Clock::now();
+            auto nearest = Clock::time_point::max();
+            auto opened  = false;
+
+            for (auto& [window, period, deadline] : m_entries) {
+                if (window->should_close()) {
+                    continue;
+                }
+
+                opened = true;
+
+                if (not period.has_value()) {
+                    m_display_rate.push_back(window);
+                    continue;
+                }
+
+                if (now < deadline) {
+                    nearest = std::min(nearest, deadline);
+                    continue;
+                }
+
+                // keep the cadence unless the window fell behind by more than a period
+                deadline += *period;
+                if (deadline < now) {
+                    deadline = now + *period;
+                }
+
+                m_due.push_back(window);
+            }
+
+            if (not m_due.empty() or not m_display_rate.empty() or not opened) {
+                break;
+            }
+
+            std::this_thread::sleep_until(nearest);
+        }
+
+        // display-rate windows go last so the vsync-ed swap belongs to a window presenting every frame
+        m_due.insert(m_due.end(), m_display_rate.begin(), m_display_rate.end());
+
+        return m_due;
+    }
+}
@@ -0,0 +1,191 @@
+#include "glfw_cpp/trace.hpp"
+
+#include <ostream>
+
+#if defined(GLFW_CPP_ENABLE_TRACE)
+
+    #include <atomic>
+    #include <format>
+    #include <memory>
+    #include <mutex>
+    #include <string_view>
+    #include <vector>
+
+    #if not defined(GLFW_CPP_TRACE_CAPACITY)
+        #define GLFW_CPP_TRACE_CAPACITY 65536
+    #endif
+
+namespace
+{
+    constexpr std::size_t capacity = GLFW_CPP_TRACE_CAPACITY;
+
+    // atomic fields so that a dump racing with a thread reusing its buffer after `clear()` reads stale values
+    // instead of being undefined behavior; relaxed stores cost the same as plain ones
+    struct Record
+    {
+        std::atomic<const char*>   name;
+        std::atomic<std::uint64_t> begin;
+        std::atomic<std::uint64_t> end;
+    };
+
+    // written only by its thread, the published size is read by dump()
+    struct Buffer
+    {
+        std::unique_ptr<Record[]>  records = std::make_unique<Record[]>(capacity);
+        std::atomic<std::size_t>   size    = 0;
+        std::atomic<std::size_t>   dropped = 0;
+        std::atomic<std::uint64_t> epoch   = 0;    // the buffer holds spans of this clear() generation
+        std::size_t                tid     = 0;
+    };
+
+    std::atomic<std::uint64_t>           g_epoch = 0;
+    std::mutex                           g_buffers_mutex;
+    std::vector<std::unique_ptr<Buffer>> g_buffers;    // never shrinks, the buffers outlive their threads
+
+    thread_local Buffer* t_buffer = nullptr;
+
+    Buffer* this_thread_buffer() noexcept
+    {
+        if (t_buffer != nullptr) {
+            return t_buffer;
+        }
+
+        try {
+            auto buffer = std::make_unique<Buffer>();
+            auto lock   = std::scoped_lock{ g_buffers_mutex };
+
+            buffer->tid   = g_buffers.size() + 1;
+            buffer->epoch = g_epoch.load(std::memory_order::relaxed);
+            t_buffer      = g_buffers.emplace_back(std::move(buffer)).get();
+        } catch (...) {
+            return nullptr;    // tracing is best effort
+        }
+
+        return t_buffer;
+    }
+
+    void write_escaped(std::ostream& out, std::string_view str)
+    {
+        for (auto ch : str) {
+            if (ch == '"' or ch == '\\') {
+                out << '\\';
+            }
+            out << ch;
+        }
+    }
+}
+
+namespace glfw_cpp::trace
+{
+    void detail::record(const char* name, std::uint64_t begin, std::uint64_t end) noexcept
+    {
+        auto* buffer = this_thread_buffer();
+        if (buffer == nullptr) {
+            return;
+        }
+
+        // the buffer is reset by its own thread, so the records are never written by two threads
+        auto epoch = g_epoch.load(std::memory_order::relaxed);
+        if (buffer->epoch.load(std::memory_order::relaxed) != epoch) {
+            buffer->size.store(0, std::memory_order::relaxed);
+            buffer->dropped.store(0, std::memory_order::relaxed);
+            buffer->epoch.store(epoch, std::memory_order::release);
+        }
+
+        auto index = buffer->size.load(std::memory_order::relaxed);
+        if (index == capacity) {
+            buffer->dropped.fetch_add(1, std::memory_order::relaxed);
+            return;
+        }
+
+        auto& record = buffer->records[index];
+        record.name.store(name, std::memory_order::relaxed);
+        record.begin.store(begin, std::memory_order::relaxed);
+        record.end.store(end, std::memory_order::relaxed);
+
+        buffer->size.store(index + 1, std::memory_order::release);
+    }
+
+    void dump(std::ostream& out)
+    {
+        auto lock  = std::scoped_lock{ g_buffers_mutex };
+        auto epoch = g_epoch.load(std::memory_order::relaxed);
+        auto first = true;
+
+        out << R"({"displayTimeUnit":"ns","traceEvents":[)";
+
+        for (const auto& buffer : g_buffers) {
+            if (buffer->epoch.load(std::memory_order::acquire) != epoch) {
+                continue;    // not reset since the last clear()
+            }
+
+            auto size = buffer->size.load(std::memory_order::acquire);
+            for (std::size_t i = 0; i < size; ++i) {
+                const auto& record = buffer->records[i];
+
+                auto begin = record.begin.load(std::memory_order::relaxed);
+                auto end   = record.end.load(std::memory_order::relaxed);
+
+                out << (first ? "\n" : ",\n") << R"({"name":")";
+                write_escaped(out, record.name.load(std::memory_order::relaxed));
+                out << std::format(
+                    R"(","ph":"X","pid":1,"tid":{},"ts":{:.3f},"dur":{:.3f}}})",
+                    buffer->tid,
+                    static_cast<double>(begin) / 1000.0,
+                    static_cast<double>(end - begin) / 1000.0
+                );
+
+                first = false;
+            }
+        }
+
+        out << "\n]}\n";
+    }
+
+    void clear() noexcept
+    {
+        g_epoch.fetch_add(1, std::memory_order::relaxed);
+    }
+
+    std::size_t dropped() noexcept
+    {
+        auto lock  = std::scoped_lock{ g_buffers_mutex };
+        auto epoch = g_epoch.load(std::memory_order::relaxed);
+        auto count = std::size_t{ 0 };
+
+        for (const auto& buffer : g_buffers) {
+            if (buffer->epoch.load(std::memory_order::acquire) == epoch) {
+                count += buffer->dropped.load(std::memory_order::relaxed);
+            }
+        }
+
+        return count;
+    }
+}
+
+#else
+
+namespace glfw_cpp::trace
+{
+    void detail::record(const char*, std::uint64_t, std::uint64_t) noexcept
+    {
+        // instrumentation disabled
+    }
+
+    void dump(std::ostream& out)
+    {
+        out << R"({"displayTimeUnit":"ns","traceEvents":[]})" << '\n';
+    }
+
+    void clear() noexcept
+    {
+        // instrumentation disabled
+    }
+
+    std::size_t dropped() noexcept
+    {
+        return 0;
+    }
+}
+
+#endif
@@ -2,6 +2,7 @@
 #define UTIL_HPP_SE5RTFRYHW6U
 
 #include "glfw_cpp/error.hpp"
+#include "glfw_cpp/result.hpp"
 
 #define GLFW_INCLUDE_NONE
 #include <GLFW/glfw3.h>
@@ -40,14 +41,12 @@ namespace util
         return old_value;
     }
 
-    inline void check_glfw_error()
+    [[noreturn]] inline void throw_error(int err_code, const char* err)
     {
-        const char* err      = nullptr;
-        const int   err_code = glfwGetError(&err);
+        assert(err_code != GLFW_NO_ERROR);
 
         // clang-format off
         switch (err_code) {
-        case GLFW_NO_ERROR:              break;
         case GLFW_NOT_INITIALIZED:       throw glfw_cpp::error::NotInitialized      { err };
         case GLFW_NO_CURRENT_CONTEXT:    throw glfw_cpp::error::NoCurrentContext    { err };
         case GLFW_INVALID_ENUM:          throw glfw_cpp::error::InvalidEnum         { err };
@@ -67,31 +66,62 @@ namespace util
         // clang-format on
     }
 
+    struct GlfwError
+    {
+        int         code        = GLFW_NO_ERROR;
+        const char* description = nullptr;
+    };
+
+    inline GlfwError get_glfw_error() noexcept
+    {
+        // with the other policies the errors are picked up by the error callback instead
+        if constexpr (glfw_cpp::error_policy == glfw_cpp::ErrorPolicy::Immediate) {
+            auto error = GlfwError{};
+            error.code = glfwGetError(&error.description);
+            return error;
+        } else {
+            return {};
+        }
+    }
+
+    inline void check_glfw_error()
+    {
+        if (auto [code, description] = get_glfw_error(); code != GLFW_NO_ERROR) {
+            throw_error(code, description);
+        }
+    }
+
+    inline glfw_cpp::Result<void> check_glfw_error_noexcept() noexcept
+    {
+        if (auto code = get_glfw_error().code; code != GLFW_NO_ERROR) {
+            return glfw_cpp::Unexpected{ static_cast<glfw_cpp::ErrorCode>(code) };
+        }
+        return {};
+    }
+
+    // for results that carry their own error (e.g. a future), so it's independent of the error policy; call
+    // `clear_glfw_error()` before the GLFW call, the other policies leave the last error set
+    inline GlfwError take_glfw_error() noexcept
+    {
+        auto error = GlfwError{};
+        error.code = glfwGetError(&error.description);
+        return error;
+    }
+
+    inline void clear_glfw_error() noexcept
+    {
+        glfwGetError(nullptr);
+    }
+
+    // for calls that can't proceed, so it's independent of the error policy
     [[noreturn]] inline void throw_glfw_error()
     {
         const char* err      = nullptr;
         const int   err_code = glfwGetError(&err);
 
-        // clang-format off
-        switch (err_code) {
-        case GLFW_NO_ERROR:              break;
-        case GLFW_NOT_INITIALIZED:       throw glfw_cpp::error::NotInitialized      { err };
-        case GLFW_NO_CURRENT_CONTEXT:    throw glfw_cpp::error::NoCurrentContext    { err };
-        case GLFW_INVALID_ENUM:          throw glfw_cpp::error::InvalidEnum         { err };
-        case GLFW_INVALID_VALUE:         throw glfw_cpp::error::InvalidValue        { err };
-        case GLFW_OUT_OF_MEMORY:         throw glfw_cpp::error::OutOfMemory         { err };
-        case GLFW_API_UNAVAILABLE:       throw glfw_cpp::error::ApiUnavailable      { err };
-        case GLFW_VERSION_UNAVAILABLE:   throw glfw_cpp::error::VersionUnavailable  { err };
-        case GLFW_PLATFORM_ERROR:        throw glfw_cpp::error::PlatformError       { err };
-        case GLFW_FORMAT_UNAVAILABLE:    throw glfw_cpp::error::FormatUnavailable   { err };
-        case GLFW_NO_WINDOW_CONTEXT:     throw glfw_cpp::error::NoWindowContext     { err };
-        case GLFW_CURSOR_UNAVAILABLE:    throw glfw_cpp::error::CursorUnavailable   { err };
-        case GLFW_FEATURE_UNAVAILABLE:   throw glfw_cpp::error::FeatureUnavailable  { err };
-        case GLFW_FEATURE_UNIMPLEMENTED: throw glfw_cpp::error::FeatureUnimplemented{ err };
-        case GLFW_PLATFORM_UNAVAILABLE:  throw glfw_cpp::error::PlatformUnavailable { err };
-        default:                         throw glfw_cpp::error::UnknownError        { "(Unhandled GLFW error code={:#010x}) {}", err_code, err};
+        if (err_code != GLFW_NO_ERROR) {
+            throw_error(err_code, err);
         }
-        // clang-format on
 
         assert(false && "Programmer mandated that error must occur, but no error occurred");
         std::terminate();
@@ -2,7 +2,9 @@
 #include "glfw_cpp/error.hpp"
 #include "glfw_cpp/event.hpp"
 #include "glfw_cpp/instance.hpp"
+#include "glfw_cpp/trace.hpp"
 
+#include "probe.hpp"
 #include "util.hpp"
 
 #define GLFW_INCLUDE_NONE
@@ -17,10 +19,44 @@
     #include "emscripten_ctx.hpp"
 #endif
 
+namespace
+{
+    glfw_cpp::dirty::Mask changes(const glfw_cpp::Snapshot& prev, const glfw_cpp::Snapshot& next) noexcept
+    {
+        namespace dirty = glfw_cpp::dirty;
+
+        auto mask = dirty::Mask{ 0 };
+        auto mark = [&](bool changed, dirty::Bit bit) { mask |= changed ? bit : 0u; };
+
+        mark(prev.position != next.position, dirty::Position);
+        mark(prev.dimensions != next.dimensions, dirty::Dimensions);
+        mark(prev.framebuffer_size != next.framebuffer_size, dirty::FramebufferSize);
+        mark(prev.content_scale != next.content_scale, dirty::ContentScale);
+        mark(prev.cursor_position != next.cursor_position, dirty::CursorPosition);
+        mark(prev.mouse_button_state != next.mouse_button_state, dirty::MouseButtonState);
+        mark(prev.key_state != next.key_state, dirty::KeyState);
+        mark(prev.attributes != next.attributes, dirty::Attributes);
+
+        return mask;
+    }
+
+    // the deltas of the delivered event must add up to the change since the last delivered one
+    template <typename E>
+    void hold_back(std::optional<E>& pending, const E& event) noexcept
+    {
+        if (pending) {
+            glfw_cpp::event::coalesce(*pending, event);
+        } else {
+            pending = event;
+        }
+    }
+}
+
 namespace glfw_cpp
 {
-    Window::Window(Handle handle, Properties&& properties, Attributes&& attributes)
+    Window::Window(Handle handle, WindowId id, Properties&& properties, Attributes&& attributes)
         : m_handle{ handle }
+        , m_id{ id }
         , m_properties{ std::move(properties) }
         , m_attributes{ std::move(attributes) }
 #if __EMSCRIPTEN__
@@ -30,20 +66,36 @@ namespace glfw_cpp
 #endif
     {
         glfwSetWindowUserPointer(m_handle, this);
+        publish_snapshot();
     }
 
     // clang-format off
     Window::Window(Window&& other) noexcept
-        : m_handle            { std::exchange(other.m_handle, nullptr) }
-        , m_properties        { std::move(other.m_properties) }
-        , m_attributes        { std::move(other.m_attributes) }
-        , m_last_frame_time   { other.m_last_frame_time }
-        , m_delta_time        { other.m_delta_time }
-        , m_vsync             { other.m_vsync }
-        , m_capture_mouse     { other.m_capture_mouse }
-        , m_has_context       { other.m_has_context }
-        , m_event_queue_front { std::move(other.m_event_queue_front) }
-        , m_event_queue_back  { std::move(other.m_event_queue_back) }
+        : m_handle                     { std::exchange(other.m_handle, nullptr) }
+        , m_id                         { std::exchange(other.m_id, {}) }
+        , m_properties                 { std::move(other.m_properties) }
+        , m_attributes                 { std::move(other.m_attributes) }
+        , m_snapshot                   { other.m_snapshot }
+        , m_dirty                      { other.m_dirty }
+        , m_dirty_back                 { other.m_dirty_back }
+        , m_last_frame_time            { other.m_last_frame_time }
+        , m_delta_time                 { other.m_delta_time }
+        , m_capture_mouse              { other.m_capture_mouse }
+        , m_has_context                { other.m_has_context }
+        , m_event_queue_front          { std::move(other.m_event_queue_front) }
+        , m_event_queue_back           { std::move(other.m_event_queue_back) }
+        , m_priority_lane              { std::move(other.m_priority_lane) }
+        , m_invalidated                { other.m_invalidated }
+        , m_overflow_policy            { other.m_overflow_policy }
+        , m_dropped                    { other.m_dropped }
+        , m_resize_policy              { other.m_resize_policy }
+        , m_pending_window_resize      { other.m_pending_window_resize }
+        , m_pending_framebuffer_resize { other.m_pending_framebuffer_resize }
+        , m_last_resize                { other.m_last_resize }
+        , m_swap_mode                  { other.m_swap_mode }
+        , m_swap_mode_effective        { other.m_swap_mode_effective }
+        , m_swap_mode_dirty            { other.m_swap_mode_dirty.load() }
+        , m_swap_tear                  { other.m_swap_tear }
     // clang-format on
     {
         glfwSetWindowUserPointer(m_handle, this);
@@ -61,19 +113,36 @@ namespace glfw_cpp
             }
 
             glfwSetWindowUserPointer(m_handle, nullptr);    // remove user pointer
-            Instance::get().request_delete_window(m_handle);
+            Instance::get().request_delete_window(m_id);
         }
 
         m_handle            = std::exchange(other.m_handle, nullptr);
+        m_id                = std::exchange(other.m_id, {});
         m_properties        = std::move(other.m_properties);
         m_attributes        = std::move(other.m_attributes);
+        m_snapshot          = other.m_snapshot;
+        m_dirty             = other.m_dirty;
+        m_dirty_back        = other.m_dirty_back;
         m_last_frame_time   = other.m_last_frame_time;
         m_delta_time        = other.m_delta_time;
-        m_vsync             = other.m_vsync;
         m_capture_mouse     = other.m_capture_mouse;
         m_has_context       = other.m_has_context;
         m_event_queue_front = std::move(other.m_event_queue_front);
         m_event_queue_back  = std::move(other.m_event_queue_back);
+        m_priority_lane     = std::move(other.m_priority_lane);
+        m_invalidated       = other.m_invalidated;
+        m_overflow_policy   = other.m_overflow_policy;
+        m_dropped           = other.m_dropped;
+
+        m_resize_policy              = other.m_resize_policy;
+        m_pending_window_resize      = other.m_pending_window_resize;
+        m_pending_framebuffer_resize = other.m_pending_framebuffer_resize;
+        m_last_resize                = other.m_last_resize;
+
+        m_swap_mode           = other.m_swap_mode;
+        m_swap_mode_effective = other.m_swap_mode_effective;
+        m_swap_mode_dirty     = other.m_swap_mode_dirty.load();
+        m_swap_tear           = other.m_swap_tear;
 
         if (m_handle != nullptr) {
             glfwSetWindowUserPointer(m_handle, this);
@@ -90,7 +159,7 @@ namespace glfw_cpp
             }
 
             glfwSetWindowUserPointer(m_handle, nullptr);    // remove user pointer
-            Instance::get().request_delete_window(m_handle);
+            Instance::get().request_delete_window(m_id);
         } else {
             // window is in invalid state (probably moved)
         }
@@ -103,7 +172,11 @@ namespace glfw_cpp
 
     void Window::iconify() noexcept
     {
-        m_attributes.iconified = true;
+        {
+            std::scoped_lock lock{ m_queue_mutex };
+            m_attributes.iconified = true;
+            publish_snapshot();
+        }
         Instance::get().enqueue_task([this] {
             glfwIconifyWindow(m_handle);
             util::check_glfw_error();
@@ -112,8 +185,12 @@ namespace glfw_cpp
 
     void Window::restore() noexcept
     {
-        m_attributes.iconified = false;
-        m_attributes.maximized = false;
+        {
+            std::scoped_lock lock{ m_queue_mutex };
+            m_attributes.iconified = false;
+            m_attributes.maximized = false;
+            publish_snapshot();
+        }
         Instance::get().enqueue_task([this] {
             glfwRestoreWindow(m_handle);
             util::check_glfw_error();
@@ -122,7 +199,11 @@ namespace glfw_cpp
 
     void Window::maximize() noexcept
     {
-        m_attributes.maximized = true;
+        {
+            std::scoped_lock lock{ m_queue_mutex };
+            m_attributes.maximized = true;
+            publish_snapshot();
+        }
         Instance::get().enqueue_task([this] {
             glfwMaximizeWindow(m_handle);
             util::check_glfw_error();
@@ -131,7 +212,11 @@ namespace glfw_cpp
 
     void Window::show() noexcept
     {
-        m_attributes.visible = true;
+        {
+            std::scoped_lock lock{ m_queue_mutex };
+            m_attributes.visible = true;
+            publish_snapshot();
+        }
         Instance::get().enqueue_task([this] {
             glfwShowWindow(m_handle);
             util::check_glfw_error();
@@ -140,7 +225,11 @@ namespace glfw_cpp
 
     void Window::hide() noexcept
     {
-        m_attributes.visible = false;
+        {
+            std::scoped_lock lock{ m_queue_mutex };
+            m_attributes.visible = false;
+            publish_snapshot();
+        }
         Instance::get().enqueue_task([this] {
             glfwHideWindow(m_handle);
             util::check_glfw_error();
@@ -149,7 +238,11 @@ namespace glfw_cpp
 
     void Window::focus() noexcept
     {
-        m_attributes.focused = true;
+        {
+            std::scoped_lock lock{ m_queue_mutex };
+            m_attributes.focused = true;
+            publish_snapshot();
+        }
         Instance::get().enqueue_task([this] {
             glfwFocusWindow(m_handle);
             util::check_glfw_error();
@@ -158,29 +251,71 @@ namespace glfw_cpp
 
     void Window::set_vsync(bool value)
     {
-        m_vsync = value;
+        if (value) {
+            set_swap_mode(swap::Vsync{});
+        } else {
+            set_swap_mode(swap::Immediate{});
+        }
+    }
 
+    void Window::set_swap_mode(swap::Mode mode)
+    {
         if (not m_has_context) {
             throw error::NoWindowContext{ "Window has no associated context" };
         }
 
-        // 0 = immediate update, 1 = update synchronized with vertical retrace
-        auto vsync = value ? 1 : 0;
+        {
+            std::scoped_lock lock{ m_swap_mutex };
+            m_swap_mode = mode;
+            m_swap_mode_dirty.store(true, std::memory_order::release);
+        }
+
+        // binding the context here would stall the driver or steal it from the thread that owns it
+        if (get_current() == m_handle and apply_swap_mode()) {
+            util::check_glfw_error();
+        }
+    }
 
-        if (auto current = get_current(); current == m_handle) {
-            glfwSwapInterval(vsync);
+    Result<void> Window::set_vsync_noexcept(bool value) noexcept
+    {
+        if (value) {
+            return set_swap_mode_noexcept(swap::Vsync{});
         } else {
-            make_current(m_handle);
-            glfwSwapInterval(vsync);
-            make_current(current);
+            return set_swap_mode_noexcept(swap::Immediate{});
+        }
+    }
+
+    Result<void> Window::set_swap_mode_noexcept(swap::Mode mode) noexcept
+    {
+        if (not m_has_context) {
+            return Unexpected{ ErrorCode::NoWindowContext };
         }
 
-        util::check_glfw_error();
+        {
+            std::scoped_lock lock{ m_swap_mutex };
+            m_swap_mode = mode;
+            m_swap_mode_dirty.store(true, std::memory_order::release);
+        }
+
+        auto current = get_current_noexcept();
+        if (not current) {
+            return Unexpected{ current.error() };
+        }
+
+        if (*current == m_handle and apply_swap_mode()) {
+            return util::check_glfw_error_noexcept();
+        }
+
+        return {};
     }
 
     void Window::set_resizable(bool value)
     {
-        m_attributes.resizable = value;
+        {
+            std::scoped_lock lock{ m_queue_mutex };
+            m_attributes.resizable = value;
+            publish_snapshot();
+        }
         Instance::get().enqueue_task([this, value] {
             glfwSetWindowAttrib(m_handle, GLFW_RESIZABLE, value ? GLFW_TRUE : GLFW_FALSE);
             util::check_glfw_error();
@@ -189,7 +324,11 @@ namespace glfw_cpp
 
     void Window::set_decorated(bool value)
     {
-        m_attributes.decorated = value;
+        {
+            std::scoped_lock lock{ m_queue_mutex };
+            m_attributes.decorated = value;
+            publish_snapshot();
+        }
         Instance::get().enqueue_task([this, value] {
             glfwSetWindowAttrib(m_handle, GLFW_RESIZABLE, value ? GLFW_TRUE : GLFW_FALSE);
             util::check_glfw_error();
@@ -198,7 +337,11 @@ namespace glfw_cpp
 
     void Window::set_auto_iconify(bool value)
     {
-        m_attributes.auto_iconify = value;
+        {
+            std::scoped_lock lock{ m_queue_mutex };
+            m_attributes.auto_iconify = value;
+            publish_snapshot();
+        }
         Instance::get().enqueue_task([this, value] {
             glfwSetWindowAttrib(m_handle, GLFW_AUTO_ICONIFY, value ? GLFW_TRUE : GLFW_FALSE);
             util::check_glfw_error();
@@ -207,7 +350,11 @@ namespace glfw_cpp
 
     void Window::set_floating(bool value)
     {
-        m_attributes.floating = value;
+        {
+            std::scoped_lock lock{ m_queue_mutex };
+            m_attributes.floating = value;
+            publish_snapshot();
+        }
         Instance::get().enqueue_task([this, value] {
             glfwSetWindowAttrib(m_handle, GLFW_FLOATING, value ? GLFW_TRUE : GLFW_FALSE);
             util::check_glfw_error();
@@ -216,7 +363,11 @@ namespace glfw_cpp
 
     void Window::set_focus_on_show(bool value)
     {
-        m_attributes.focus_on_show = value;
+        {
+            std::scoped_lock lock{ m_queue_mutex };
+            m_attributes.focus_on_show = value;
+            publish_snapshot();
+        }
         Instance::get().enqueue_task([this, value] {
             glfwSetWindowAttrib(m_handle, GLFW_FOCUS_ON_SHOW, value ? GLFW_TRUE : GLFW_FALSE);
             util::check_glfw_error();
@@ -225,7 +376,11 @@ namespace glfw_cpp
 
     void Window::set_mouse_passthrough(bool value)
     {
-        m_attributes.mouse_passthrough = value;
+        {
+            std::scoped_lock lock{ m_queue_mutex };
+            m_attributes.mouse_passthrough = value;
+            publish_snapshot();
+        }
         Instance::get().enqueue_task([this, value] {
             glfwSetWindowAttrib(m_handle, GLFW_MOUSE_PASSTHROUGH, value ? GLFW_TRUE : GLFW_FALSE);
             util::check_glfw_error();
@@ -234,7 +389,11 @@ namespace glfw_cpp
 
     void Window::set_window_size(int width, int height) noexcept
     {
-        m_properties.dimensions = { .width = width, .height = height };
+        {
+            std::scoped_lock lock{ m_queue_mutex };
+            m_properties.dimensions = { .width = width, .height = height };
+            publish_snapshot();
+        }
         Instance::get().enqueue_task([this, width, height] {
             glfwSetWindowSize(m_handle, width, height);
             util::check_glfw_error();
@@ -243,7 +402,11 @@ namespace glfw_cpp
 
     void Window::set_window_pos(int x, int y) noexcept
     {
-        m_properties.position = { .x = x, .y = y };
+        {
+            std::scoped_lock lock{ m_queue_mutex };
+            m_properties.position = { .x = x, .y = y };
+            publish_snapshot();
+        }
         Instance::get().enqueue_task([this, x, y] {
             glfwSetWindowPos(m_handle, x, y);
             util::check_glfw_error();
@@ -300,25 +463,125 @@ namespace glfw_cpp
 
     const EventQueue& Window::swap_events() noexcept
     {
+        auto span = trace::Span{ "Window::swap_events" };
+
         std::scoped_lock lock{ m_queue_mutex };
-        m_event_queue_front.swap(m_event_queue_back);
-        m_event_queue_back.reset();
+        release_resize_events();
+        m_priority_lane.swap_merged(m_event_queue_back, m_event_queue_front);
+        m_invalidated = false;
+        m_dirty       = std::exchange(m_dirty_back, 0);
+
+        GLFW_CPP_PROBE(swap_events, m_handle, m_event_queue_front.size());
         return m_event_queue_front;
     }
 
+    void Window::invalidate() noexcept
+    {
+        {
+            std::scoped_lock lock{ m_queue_mutex };
+            m_invalidated = true;
+        }
+        m_queue_cv.notify_all();
+    }
+
+    bool Window::wait_for_events(std::optional<std::chrono::milliseconds> timeout)
+    {
+        auto lock  = std::unique_lock{ m_queue_mutex };
+        auto ready = [&] {
+            return not m_event_queue_back.empty() or not m_priority_lane.empty() or m_invalidated
+                or resize_events_due() or should_close();
+        };
+
+        auto deadline = std::chrono::steady_clock::time_point::max();
+        if (timeout) {
+            deadline = std::chrono::steady_clock::now() + *timeout;
+        }
+
+        while (not ready()) {
+            // a debounced resize becomes due without any notification
+            auto wake = deadline;
+            if (auto* debounce = std::get_if<resize::Debounce>(&m_resize_policy); debounce != nullptr) {
+                if (m_pending_window_resize or m_pending_framebuffer_resize) {
+                    wake = std::min(wake, m_last_resize + debounce->quiet);
+                }
+            }
+
+            if (wake == std::chrono::steady_clock::time_point::max()) {
+                m_queue_cv.wait(lock);
+            } else if (m_queue_cv.wait_until(lock, wake) == std::cv_status::timeout and wake == deadline) {
+                return ready();
+            }
+        }
+
+        return true;
+    }
+
     double Window::swap_buffers()
     {
+        auto span = trace::Span{ "Window::swap_buffers" };
+        GLFW_CPP_PROBE(swap_buffers_entry, m_handle);
+
         if (m_has_context) {
+            // a single atomic load per frame unless a mode is pending
+            if (m_swap_mode_dirty.load(std::memory_order::acquire) and get_current() == m_handle
+                and apply_swap_mode()) {
+                util::check_glfw_error();
+            }
             glfwSwapBuffers(m_handle);
             util::check_glfw_error();
         }
         update_delta_time();
+
+        GLFW_CPP_PROBE(swap_buffers_return, m_handle);
+        return m_delta_time;
+    }
+
+    Result<double> Window::swap_buffers_noexcept() noexcept
+    {
+        auto span = trace::Span{ "Window::swap_buffers" };
+        GLFW_CPP_PROBE(swap_buffers_entry, m_handle);
+
+        if (m_has_context) {
+            if (m_swap_mode_dirty.load(std::memory_order::acquire)) {
+                auto current = get_current_noexcept();
+                if (not current) {
+                    return Unexpected{ current.error() };
+                }
+
+                if (*current == m_handle and apply_swap_mode()) {
+                    if (auto res = util::check_glfw_error_noexcept(); not res) {
+                        return Unexpected{ res.error() };
+                    }
+                }
+            }
+
+            glfwSwapBuffers(m_handle);
+            if (auto res = util::check_glfw_error_noexcept(); not res) {
+                return Unexpected{ res.error() };
+            }
+        }
+        update_delta_time();
+
+        GLFW_CPP_PROBE(swap_buffers_return, m_handle);
         return m_delta_time;
     }
 
+    void Window::cancel_close() noexcept
+    {
+        glfwSetWindowShouldClose(m_handle, 0);
+        Instance::get().m_windows.mark_open(m_id);
+    }
+
     void Window::request_close() noexcept
     {
         glfwSetWindowShouldClose(m_handle, 1);
+        Instance::get().m_windows.mark_closed(m_id);
+
+        // the empty critical section orders the flag with the predicate check of a waiting thread
+        {
+            std::scoped_lock lock{ m_queue_mutex };
+        }
+        m_queue_cv.notify_all();
     }
 
     void Window::set_capture_mouse(bool value) noexcept
@@ -341,20 +604,120 @@ namespace glfw_cpp
         m_event_queue_back.resize(new_size, EventQueue::ResizePolicy::DiscardOld);
     }
 
-    void Window::push_event(Event&& event) noexcept
+    void Window::set_event_type_index(bool enabled) noexcept
     {
         std::scoped_lock lock{ m_queue_mutex };
+        m_event_queue_front.set_type_index(enabled);
+        m_event_queue_back.set_type_index(enabled);
+    }
+
+    void Window::set_overflow_policy(overflow::Policy policy) noexcept
+    {
+        std::scoped_lock lock{ m_queue_mutex };
+        m_overflow_policy = policy;
+    }
+
+    overflow::Policy Window::overflow_policy() const noexcept
+    {
+        std::scoped_lock lock{ m_queue_mutex };
+        return m_overflow_policy;
+    }
+
+    EventDrops Window::dropped_events() const noexcept
+    {
+        std::scoped_lock lock{ m_queue_mutex };
+        return m_dropped;
+    }
+
+    void Window::reset_dropped_events() noexcept
+    {
+        std::scoped_lock lock{ m_queue_mutex };
+        m_dropped = {};
+    }
+
+    void Window::set_resize_policy(resize::Policy policy) noexcept
+    {
+        std::scoped_lock lock{ m_queue_mutex };
+        m_resize_policy = policy;
+    }
+
+    resize::Policy Window::resize_policy() const noexcept
+    {
+        std::scoped_lock lock{ m_queue_mutex };
+        return m_resize_policy;
+    }
+
+    bool Window::is_vsync() const noexcept
+    {
+        std::scoped_lock lock{ m_swap_mutex };
+        return not std::holds_alternative<swap::Immediate>(m_swap_mode);
+    }
+
+    swap::Mode Window::swap_mode() const noexcept
+    {
+        std::scoped_lock lock{ m_swap_mutex };
+        return m_swap_mode;
+    }
+
+    std::optional<swap::Mode> Window::effective_swap_mode() const noexcept
+    {
+        std::scoped_lock lock{ m_swap_mutex };
+        return m_swap_mode_effective;
+    }
+
+    bool Window::apply_swap_mode() noexcept
+    {
+        if (not m_swap_mode_dirty.load(std::memory_order::acquire)) {
+            return false;
+        }
+
+        std::scoped_lock lock{ m_swap_mutex };
+        if (not m_swap_mode_dirty.exchange(false, std::memory_order::relaxed)) {
+            return false;    // applied by a racing call
+        }
+
+        // the extension query needs the context to be current, which is the case here
+        if (std::holds_alternative<swap::Adaptive>(m_swap_mode) and not m_swap_tear.has_value()) {
+            m_swap_tear = glfwExtensionSupported("WGL_EXT_swap_control_tear") == GLFW_TRUE
+                       or glfwExtensionSupported("GLX_EXT_swap_control_tear") == GLFW_TRUE;
+        }
+
+        auto [effective, interval] = std::visit(
+            util::VisitOverloaded{
+                [](swap::Immediate mode) { return std::pair<swap::Mode, int>{ mode, 0 }; },
+                [](swap::Vsync mode) { return std::pair<swap::Mode, int>{ mode, mode.interval }; },
+                [&](swap::Adaptive mode) {
+                    if (m_swap_tear.value_or(false)) {
+                        return std::pair<swap::Mode, int>{ mode, -mode.interval };
+                    }
+                    return std::pair<swap::Mode, int>{ swap::Vsync{ mode.interval }, mode.interval };
+                },
+            },
+            m_swap_mode
+        );
+
+        glfwSwapInterval(interval);    // the error, if any, is checked by the caller
+
+        m_swap_mode_effective = effective;
+        return true;
+    }
+
+    void Window::push_event(Event&& event) noexcept
+    {
+        auto lock = std::unique_lock{ m_queue_mutex };
 
         // intercept some events to update properties before pushing them to the queue
         using KS = KeyState;
         using MS = MouseButtonState;
 
-        auto& [title, pos, dim, frame, cursor, btns, keys, mon] = m_properties;
+        auto& [title, pos, dim, frame, scale, cursor, btns, keys, mon] = m_properties;
+        auto updated = true;    // whether the event changed a property, published below
         event.visit(util::VisitOverloaded{
             // clang-format off
             [&](event::WindowMoved&        e) { pos    = { .x     = e.x,     .y      = e.y   }; },
             [&](event::WindowResized&      e) { dim    = { .width = e.width, .height = e.height }; },
             [&](event::FramebufferResized& e) { frame  = { .width = e.width, .height = e.height }; },
+            [&](event::WindowScaleChanged& e) { scale  = { .x     = e.x,     .y      = e.y      }; },
             [&](event::CursorMoved&        e) { cursor = { .x     = e.x,     .y      = e.y      }; },
             [&](event::CursorEntered&      e) { m_attributes.hovered   = e.entered;   },
             [&](event::WindowFocused&      e) { m_attributes.focused   = e.focused;   },
@@ -362,11 +725,86 @@ namespace glfw_cpp
             [&](event::WindowMaximized&    e) { m_attributes.maximized = e.maximized; },
             [&](event::KeyPressed&         e) { keys.set_value(e.key,    e.state != KS::Release); },
             [&](event::ButtonPressed&      e) { btns.set_value(e.button, e.state != MS::Release); },
-            [&] /* else */ (auto&)         { /* do nothing */ }
+            [&] /* else */ (auto&)         { updated = false; }
             // clang-format on
         });
 
-        m_event_queue_back.push(std::move(event));
+        if (updated) {
+            publish_snapshot();
+        }
+
+        // only the latest resize event of each kind is kept, the rest are delivered as usual
+        if (std::holds_alternative<resize::Immediate>(m_resize_policy)) {
+            push_back_event(std::move(event));
+        } else if (auto* e = event.get_if<event::WindowResized>()) {
+            hold_back(m_pending_window_resize, *e);
+            m_last_resize = std::chrono::steady_clock::now();
+        } else if (auto* e = event.get_if<event::FramebufferResized>()) {
+            hold_back(m_pending_framebuffer_resize, *e);
+            m_last_resize = std::chrono::steady_clock::now();
+        } else {
+            push_back_event(std::move(event));
+        }
+
+        lock.unlock();
+        m_queue_cv.notify_all();
+    }
+
+    void Window::publish_snapshot() noexcept
+    {
+        auto snapshot = Snapshot{
+            .position           = m_properties.position,
+            .dimensions         = m_properties.dimensions,
+            .framebuffer_size   = m_properties.framebuffer_size,
+            .content_scale      = m_properties.content_scale,
+            .cursor_position    = m_properties.cursor_position,
+            .mouse_button_state = m_properties.mouse_button_state,
+            .key_state          = m_properties.key_state,
+            .attributes         = m_attributes,
+        };
+
+        // the writers are serialized by m_queue_mutex, so this load never retries
+        m_dirty_back |= changes(m_snapshot.load(), snapshot);
+        m_snapshot.store(snapshot);
+    }
+
+    void Window::push_back_event(Event&& event) noexcept
+    {
+        auto dropped = m_priority_lane.push(m_event_queue_back, std::move(event), m_overflow_policy);
+        if (dropped) {
+            GLFW_CPP_PROBE(queue_overflow, m_handle, dropped->variant.index(), m_event_queue_back.capacity());
+            m_dropped.record(*dropped);
+        }
+    }
+
+    bool Window::resize_events_due() const noexcept
+    {
+        if (not m_pending_window_resize and not m_pending_framebuffer_resize) {
+            return false;
+        }
+
+        auto elapsed = std::chrono::steady_clock::now() - m_last_resize;
+        return std::visit(
+            util::VisitOverloaded{
+                [&](const resize::Debounce& policy) { return elapsed >= policy.quiet; },
+                [&](const auto&) { return true; },
+            },
+            m_resize_policy
+        );
+    }
+
+    void Window::release_resize_events() noexcept
+    {
+        if (not resize_events_due()) {
+            return;
+        }
+
+        if (m_pending_window_resize) {
+            push_back_event(*std::exchange(m_pending_window_resize, std::nullopt));
+        }
+        if (m_pending_framebuffer_resize) {
+            push_back_event(*std::exchange(m_pending_framebuffer_resize, std::nullopt));
+        }
     }
 
     void Window::update_delta_time() noexcept
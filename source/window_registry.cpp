@@ -0,0 +1,111 @@
+#include "glfw_cpp/window_registry.hpp"
+
+#include <utility>
+
+namespace glfw_cpp
+{
+    WindowId WindowRegistry::insert(GLFWwindow* handle)
+    {
+        auto lock = std::scoped_lock{ m_mutex };
+
+        auto index = std::uint32_t{};
+        if (not m_free.empty()) {
+            index = m_free.back();
+            m_free.pop_back();
+        } else {
+            index = static_cast<std::uint32_t>(m_slots.size());
+            m_slots.emplace_back();
+            m_free.reserve(m_slots.size());
+        }
+
+        auto& slot  = m_slots[index];
+        slot.handle = handle;
+        slot.open   = true;
+
+        ++m_size;
+        m_open.fetch_add(1, std::memory_order::release);
+
+        return { .index = index, .generation = slot.generation };
+    }
+
+    GLFWwindow* WindowRegistry::erase(WindowId id) noexcept
+    {
+        auto lock = std::scoped_lock{ m_mutex };
+
+        auto* slot = find(id);
+        if (slot == nullptr) {
+            return nullptr;
+        }
+
+        if (slot->open) {
+            m_open.fetch_sub(1, std::memory_order::release);
+        }
+
+        auto handle = std::exchange(slot->handle, nullptr);
+        slot->open  = false;
+        ++slot->generation;
+
+        --m_size;
+        m_free.push_back(id.index);
+
+        return handle;
+    }
+
+    GLFWwindow* WindowRegistry::get(WindowId id) const noexcept
+    {
+        auto  lock = std::scoped_lock{ m_mutex };
+        auto* slot = find(id);
+        return slot != nullptr ? slot->handle : nullptr;
+    }
+
+    bool WindowRegistry::mark_closed(WindowId id) noexcept
+    {
+        auto lock = std::scoped_lock{ m_mutex };
+
+        auto* slot = find(id);
+        if (slot == nullptr or not slot->open) {
+            return false;
+        }
+
+        slot->open = false;
+        m_open.fetch_sub(1, std::memory_order::release);
+
+        return true;
+    }
+
+    bool WindowRegistry::mark_open(WindowId id) noexcept
+    {
+        auto lock = std::scoped_lock{ m_mutex };
+
+        auto* slot = find(id);
+        if (slot == nullptr or slot->open) {
+            return false;
+        }
+
+        slot->open = true;
+        m_open.fetch_add(1, std::memory_order::release);
+
+        return true;
+    }
+
+    std::size_t WindowRegistry::size() const noexcept
+    {
+        auto lock = std::scoped_lock{ m_mutex };
+        return m_size;
+    }
+
+    WindowRegistry::Slot* WindowRegistry::find(WindowId id) noexcept
+    {
+        if (id.index >= m_slots.size()) {
+            return nullptr;
+        }
+
+        auto& slot = m_slots[id.index];
+        return slot.handle != nullptr and slot.generation == id.generation ? &slot : nullptr;
+    }
+
+    const WindowRegistry::Slot* WindowRegistry::find(WindowId id) const noexcept
+    {
+        return const_cast<WindowRegistry*>(this)->find(id);
+    }
+}
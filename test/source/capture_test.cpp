@@ -0,0 +1,234 @@
+#include <boost/ut.hpp>
+
+#include <glfw_cpp/capture.hpp>
+#include <glfw_cpp/instance.hpp>
+#include <glfw_cpp/window.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace ut      = boost::ut;
+namespace capture = glfw_cpp::capture;
+
+// the GL driver keeps allocations alive until the process exits
+extern "C" const char* __asan_default_options()
+{
+    return "detect_leaks=0";
+}
+
+struct Context
+{
+    glfw_cpp::Instance::Unique glfw;
+    glfw_cpp::Window           window;
+};
+
+/**
+ * Create a hidden window with an OpenGL 3.3 context, preferring the headless Null platform so the test can
+ * run on Mesa llvmpipe without a display.
+ */
+std::optional<Context> create_context()
+{
+    using glfw_cpp::hint::Platform, glfw_cpp::gl::CreationApi;
+
+    for (auto platform : { Platform::Null, Platform::Any }) {
+        try {
+            if (not glfw_cpp::platform_supported(platform)) {
+                continue;
+            }
+
+            auto glfw = glfw_cpp::init({ .platform = platform });
+            for (auto creation_api : { CreationApi::EGL, CreationApi::OSMesa, CreationApi::Native }) {
+                glfw->apply_hints({
+                    .api = glfw_cpp::api::OpenGL{
+                        .version_major = 3,
+                        .version_minor = 3,
+                        .creation_api  = creation_api,
+                    },
+                    .window = { .visible = false },
+                });
+
+                try {
+                    auto window = glfw->create_window(64, 48, "capture_test");
+                    return Context{ std::move(glfw), std::move(window) };
+                } catch (const glfw_cpp::error::Error&) {
+                    continue;    // creation API not available
+                }
+            }
+        } catch (const glfw_cpp::error::Error&) {
+            continue;    // platform not available
+        }
+    }
+
+    return std::nullopt;
+}
+
+std::vector<std::byte> read_file(const std::filesystem::path& path)
+{
+    auto file = std::ifstream{ path, std::ios::binary };
+    auto data = std::vector<std::byte>(std::filesystem::file_size(path));
+    file.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size()));
+    return data;
+}
+
+template <typename T>
+T read_at(const std::vector<std::byte>& data, std::size_t offset)
+{
+    auto value = T{};
+    if (offset + sizeof(T) <= data.size()) {
+        std::memcpy(&value, data.data() + offset, sizeof(T));
+    }
+    return value;
+}
+
+std::vector<capture::FrameHeader> read_frames(const std::vector<std::byte>& data)
+{
+    auto frames = std::vector<capture::FrameHeader>{};
+    auto offset = sizeof(capture::FileHeader);
+
+    while (offset + sizeof(capture::FrameHeader) <= data.size()) {
+        auto frame = read_at<capture::FrameHeader>(data, offset);
+        if (frame.magic != capture::FrameHeader::s_magic) {
+            break;
+        }
+        frames.push_back(frame);
+        offset += sizeof(frame) + frame.payload_size;
+    }
+
+    return frames;
+}
+
+int main()
+{
+    using ut::expect, ut::that;
+    using namespace ut::literals;
+    using namespace ut::operators;
+
+    auto context = create_context();
+    if (not context.has_value()) {
+        std::puts("capture_test: no OpenGL 3.3 context available, skipped");
+        return 0;
+    }
+
+    auto& window = context->window;
+    glfw_cpp::make_current(window.handle());
+
+    using ClearColor = void (*)(float, float, float, float);
+    using Clear      = void (*)(unsigned int);
+
+    auto clear_color = reinterpret_cast<ClearColor>(glfw_cpp::get_proc_address("glClearColor"));
+    auto clear       = reinterpret_cast<Clear>(glfw_cpp::get_proc_address("glClear"));
+
+    constexpr auto color_buffer_bit = 0x00004000u;
+
+    const auto width      = window.snapshot().framebuffer_size.width;
+    const auto height     = window.snapshot().framebuffer_size.height;
+    const auto frame_size = static_cast<std::size_t>(width) * static_cast<std::size_t>(height) * 4;
+
+    const auto path = std::filesystem::temp_directory_path() / "glfw_cpp_capture_test.gcap";
+
+    // the tests run right away, while the context is alive
+    "every frame should be read back and written when waited on"_test = [&] {
+        constexpr auto frame_count = std::size_t{ 10 };
+
+        auto stats = capture::Stats{};
+        {
+            // a ring of 2 is reused 5 times and the file outgrows its reservation
+            auto frame_capture = capture::FrameCapture{
+                window,
+                { .path = path, .format = capture::Format::Raw, .ring_size = 2, .reserve = 4096 },
+            };
+
+            for (auto i = std::size_t{ 0 }; i < frame_count; ++i) {
+                clear_color(static_cast<float>(i * 20) / 255.0f, 0.0f, 1.0f, 1.0f);
+                clear(color_buffer_bit);
+                frame_capture.capture();
+                frame_capture.flush();
+            }
+
+            stats = frame_capture.stats();
+        }
+
+        expect(that % stats.issued == frame_count);
+        expect(that % stats.written == frame_count);
+        expect(that % stats.dropped == 0u);
+
+        auto data = read_file(path);
+        expect(that % data.size() == stats.bytes) << "the file was not truncated to its content";
+        expect(that % read_at<capture::FileHeader>(data, 0).magic == capture::FileHeader::s_magic);
+
+        auto frames = read_frames(data);
+        expect(that % frames.size() == frame_count);
+
+        auto offset = sizeof(capture::FileHeader);
+        for (auto i = std::size_t{ 0 }; i < frames.size(); ++i) {
+            const auto& frame = frames[i];
+            expect(that % frame.width == static_cast<std::uint32_t>(width));
+            expect(that % frame.height == static_cast<std::uint32_t>(height));
+            expect(frame.format == capture::Format::Raw);
+            expect(that % frame.payload_size == frame_size);
+            if (i > 0) {
+                expect(that % frame.timestamp_ns >= frames[i - 1].timestamp_ns);
+            }
+
+            // every pixel holds the clear color of its frame
+            auto pixel = offset + sizeof(frame) + frame_size / 2;
+            expect(that % int{ read_at<std::uint8_t>(data, pixel + 0) } == static_cast<int>(i) * 20);
+            expect(that % int{ read_at<std::uint8_t>(data, pixel + 2) } == 255);
+            expect(that % int{ read_at<std::uint8_t>(data, pixel + 3) } == 255);
+
+            offset += sizeof(frame) + frame.payload_size;
+        }
+    };
+
+    "a full ring should drop frames instead of stalling"_test = [&] {
+        constexpr auto frame_count = std::size_t{ 8 };
+
+        auto stats = capture::Stats{};
+        {
+            auto frame_capture = capture::FrameCapture{
+                window,
+                { .path = path, .format = capture::Format::Qoi, .ring_size = 2 },
+            };
+
+            // nothing waits on the readbacks, a slot is only freed when the GPU and the encoder are done
+            for (auto i = std::size_t{ 0 }; i < frame_count; ++i) {
+                clear(color_buffer_bit);
+                frame_capture.capture();
+            }
+
+            frame_capture.flush();
+            stats = frame_capture.stats();
+        }
+
+        // the first readbacks always find a free slot, every frame is either written or dropped
+        expect(that % stats.issued >= 2u);
+        expect(that % stats.issued <= frame_count);
+        expect(that % stats.written + stats.dropped == frame_count);
+
+        auto data = read_file(path);
+        expect(that % data.size() == stats.bytes);
+
+        auto frames = read_frames(data);
+        expect(that % frames.size() == stats.written);
+
+        auto offset = sizeof(capture::FileHeader);
+        for (const auto& frame : frames) {
+            auto magic = read_at<std::array<char, 4>>(data, offset + sizeof(frame));
+            expect(frame.format == capture::Format::Qoi);
+            expect(std::string_view{ magic.data(), magic.size() } == "qoif");
+            expect(that % frame.payload_size <= capture::detail::qoi_max_size(frame.width, frame.height));
+
+            offset += sizeof(frame) + frame.payload_size;
+        }
+    };
+
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,271 @@
+#include <boost/ut.hpp>
+
+#include <glfw_cpp/coroutine.hpp>
+#include <glfw_cpp/instance.hpp>
+#include <glfw_cpp/window.hpp>
+
+#include <initializer_list>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace ut = boost::ut;
+namespace co = glfw_cpp::co;
+namespace ev = glfw_cpp::event;
+
+using glfw_cpp::Instance;
+using glfw_cpp::Window;
+
+using Log = std::vector<std::string>;
+
+// each window move queues a `WindowMoved` with the new x position, delivered on the next tick
+void move_window(Instance& glfw, Window& window, std::initializer_list<int> xs)
+{
+    for (auto x : xs) {
+        window.set_window_pos(x, 0);
+    }
+    glfw.poll_events();
+}
+
+co::Task count_frames(Window& window, std::string name, int frames, Log& log)
+{
+    for (auto i = 0; i < frames; ++i) {
+        log.push_back(name + std::to_string(i));
+        co_await window.next_frame();
+    }
+}
+
+co::Task frame_after_event(Window& window, Log& log)
+{
+    auto moved = co_await window.next<ev::WindowMoved>();
+    log.push_back("moved " + std::to_string(moved.x));
+
+    co_await window.next_frame();
+    log.push_back("frame");
+}
+
+co::Task frame_after_future(Instance& glfw, Window& window, Log& log)
+{
+    auto value = co_await glfw.on_main_thread([] { return 42; });
+    log.push_back("future " + std::to_string(value));
+
+    co_await window.next_frame();
+    log.push_back("frame");
+}
+
+co::Task collect_moves(Window& window, std::string name, int count, Log& log)
+{
+    for (auto i = 0; i < count; ++i) {
+        auto moved = co_await window.next<ev::WindowMoved>();
+        log.push_back(name + std::to_string(moved.x));
+    }
+}
+
+co::Task wait_resize(Window& window, Log& log)
+{
+    co_await window.next<ev::WindowResized>();
+    log.push_back("resized");
+}
+
+co::Task take_owned(Instance& glfw, Log& log)
+{
+    // named, GCC 12 frees the captures of a lambda temporary in a co_await expression twice
+    auto fn    = [owned = std::make_unique<int>(3)] { return *owned; };
+    auto value = co_await glfw.on_main_thread(std::move(fn));
+    log.push_back("owned " + std::to_string(value));
+}
+
+co::Task fail_next_frame(Window& window)
+{
+    co_await window.next_frame();
+    throw std::runtime_error{ "inner" };
+}
+
+co::Task rethrow_as_logic_error(Window& window, Log& log)
+{
+    try {
+        co_await fail_next_frame(window);
+    } catch (const std::runtime_error& e) {
+        log.push_back(e.what());
+        throw std::logic_error{ "outer" };
+    }
+}
+
+co::Task fail_right_away()
+{
+    throw std::runtime_error{ "spawn" };
+    co_return;
+}
+
+// counts the destruction of the frames holding it
+struct Guard
+{
+    int& destroyed;
+    ~Guard() { ++destroyed; }
+};
+
+co::Task guarded_event(Window& window, int& destroyed)
+{
+    auto guard = Guard{ destroyed };
+    co_await window.next<ev::WindowMoved>();
+}
+
+co::Task guarded_nested(Window& window, int& destroyed)
+{
+    auto guard = Guard{ destroyed };
+    co_await guarded_event(window, destroyed);
+}
+
+co::Task guarded_frame(Window& window, int& destroyed)
+{
+    auto guard = Guard{ destroyed };
+    for (;;) {
+        co_await window.next_frame();
+    }
+}
+
+co::Task guarded_future(Instance& glfw, int& destroyed)
+{
+    auto guard = Guard{ destroyed };
+    co_await glfw.on_main_thread([] { return 0; });
+}
+
+int main()
+{
+    using ut::expect, ut::that, ut::throws;
+    using namespace ut::literals;
+    using namespace ut::operators;
+
+    // the null platform is always available and moves its windows right away
+    auto glfw = glfw_cpp::init({ .platform = glfw_cpp::hint::Platform::Null });
+    glfw->apply_hints({ .api = glfw_cpp::api::NoApi{} });
+
+    auto window = glfw->create_window(64, 64, "coroutine_test");
+
+    // drop the events of the window creation so each test starts with an empty queue
+    auto flush = [&] {
+        glfw->poll_events();
+        window.swap_events();
+    };
+
+    "next_frame should resume each task once per tick in spawn order"_test = [&] {
+        flush();
+
+        auto log    = Log{};
+        auto runner = co::Runner{ window };
+        runner.spawn(count_frames(window, "a", 3, log));
+        runner.spawn(count_frames(window, "b", 2, log));
+        expect(log == Log{ "a0", "b0" });
+
+        runner.tick();
+        expect(log == Log{ "a0", "b0", "a1", "b1" });
+
+        runner.tick();
+        expect(log == Log{ "a0", "b0", "a1", "b1", "a2" });
+        expect(that % not runner.empty());
+
+        runner.tick();
+        expect(that % runner.empty());
+    };
+
+    "a task resumed by an event or a future should wait for the next tick for its frame"_test = [&] {
+        flush();
+
+        auto log    = Log{};
+        auto runner = co::Runner{ window };
+        runner.spawn(frame_after_event(window, log));
+        runner.spawn(frame_after_future(*glfw, window, log));
+
+        // the move and the main thread task complete before the same tick
+        move_window(*glfw, window, { 101 });
+        runner.tick();
+        expect(log == Log{ "future 42", "moved 101" });
+
+        runner.tick();
+        expect(log == Log{ "future 42", "moved 101", "frame", "frame" });
+        expect(that % runner.empty());
+    };
+
+    "events should be delivered in queue order to the tasks waiting for their type"_test = [&] {
+        flush();
+
+        auto log    = Log{};
+        auto runner = co::Runner{ window };
+        runner.spawn(collect_moves(window, "all ", 3, log));
+        runner.spawn(collect_moves(window, "once ", 1, log));
+        runner.spawn(wait_resize(window, log));
+
+        // a task waiting again is resumed by the next event of the frame, not the same one
+        move_window(*glfw, window, { 201, 202, 203 });
+        runner.tick();
+        expect(log == Log{ "all 201", "once 201", "all 202", "all 203" });
+
+        // the other type is still awaited
+        expect(that % not runner.empty());
+        window.set_window_size(80, 80);
+        glfw->poll_events();
+        runner.tick();
+        expect(log.back() == "resized");
+        expect(that % runner.empty());
+    };
+
+    "main thread tasks should accept move-only functions"_test = [&] {
+        flush();
+
+        auto submitted = glfw->submit_task([owned = std::make_unique<int>(1)] { return *owned; });
+        auto invoked   = glfw->invoke_on_main([owned = std::make_unique<int>(2)] { return *owned; });
+
+        auto log    = Log{};
+        auto runner = co::Runner{ window };
+        runner.spawn(take_owned(*glfw, log));
+
+        glfw->poll_events();
+        runner.tick();
+
+        expect(that % submitted.get() == 1);
+        expect(that % invoked == 2);
+        expect(log == Log{ "owned 3" });
+    };
+
+    "an exception should propagate through awaiting tasks and out of the tick"_test = [&] {
+        flush();
+
+        auto log    = Log{};
+        auto runner = co::Runner{ window };
+        runner.spawn(rethrow_as_logic_error(window, log));
+        runner.spawn(count_frames(window, "", 3, log));
+
+        expect(throws<std::logic_error>([&] { runner.tick(); }));
+        expect(log == Log{ "0", "inner", "1" });
+
+        // the failed task is destroyed, the other one keeps running
+        expect(that % not runner.empty());
+        runner.tick();
+        runner.tick();
+        expect(log.back() == "2");
+        expect(that % runner.empty());
+
+        // a task failing before its first suspension throws out of spawn
+        expect(throws<std::runtime_error>([&] { runner.spawn(fail_right_away()); }));
+        expect(that % runner.empty());
+    };
+
+    "destroying the runner should destroy the suspended tasks"_test = [&] {
+        flush();
+
+        auto destroyed = 0;
+        {
+            auto runner = co::Runner{ window };
+            runner.spawn(guarded_nested(window, destroyed));
+            runner.spawn(guarded_frame(window, destroyed));
+            runner.spawn(guarded_future(*glfw, destroyed));
+            runner.tick();
+            expect(that % destroyed == 0);
+        }
+        expect(that % destroyed == 4);
+
+        // the main thread task still runs, its future is gone
+        glfw->poll_events();
+    };
+}
@@ -0,0 +1,101 @@
+#include <boost/ut.hpp>
+
+#include <glfw_cpp/helper.hpp>
+
+#include <chrono>
+
+namespace ut = boost::ut;
+
+using glfw_cpp::helper::time::Debouncer;
+
+using Clock = Debouncer::Clock;
+using std::chrono::milliseconds;
+
+constexpr auto quiet = milliseconds{ 50 };
+
+// fake clock, the tests never look at the real time
+Clock::time_point at(int ms)
+{
+    return Clock::time_point{} + milliseconds{ ms };
+}
+
+int main()
+{
+    using ut::expect, ut::that;
+    using namespace ut::literals;
+    using namespace ut::operators;
+
+    [[maybe_unused]] ut::suite debouncer_tests = [] {
+        "nothing should be due when nothing was requested"_test = [] {
+            auto debouncer = Debouncer{};
+
+            expect(that % not debouncer.pending());
+            expect(that % not debouncer.due(quiet, at(1000)));
+        };
+
+        "a poke should be due once the quiet period elapsed"_test = [] {
+            auto debouncer = Debouncer{};
+            debouncer.poke(at(0));
+
+            expect(that % debouncer.pending());
+            expect(that % not debouncer.due(quiet, at(49)));
+            expect(that % debouncer.due(quiet, at(50)));
+        };
+
+        "every poke should restart the quiet period"_test = [] {
+            auto debouncer = Debouncer{};
+
+            // a resize every 10 ms for 100 ms
+            for (auto time = 0; time <= 100; time += 10) {
+                debouncer.poke(at(time));
+                expect(that % not debouncer.due(quiet, at(time)));
+            }
+
+            expect(that % not debouncer.due(quiet, at(149)));
+            expect(that % debouncer.due(quiet, at(150)));
+        };
+
+        "repeated requests should not postpone the action"_test = [] {
+            auto debouncer = Debouncer{};
+
+            // a swapchain that stays suboptimal reports it on every acquire and present
+            auto time = 0;
+            while (not debouncer.due(quiet, at(time))) {
+                debouncer.request(at(time));
+                time += 5;
+                expect(that % time <= 1000) << "never due";
+                if (time > 1000) {
+                    return;
+                }
+            }
+            expect(that % time == 50);
+        };
+
+        "a request should not shorten an ongoing quiet period"_test = [] {
+            auto debouncer = Debouncer{};
+
+            debouncer.poke(at(0));
+            debouncer.request(at(30));
+            debouncer.poke(at(40));
+
+            expect(that % not debouncer.due(quiet, at(60)));
+            expect(that % debouncer.due(quiet, at(90)));
+        };
+
+        "an expedited action should be due right away"_test = [] {
+            auto debouncer = Debouncer{};
+
+            debouncer.poke(at(0));
+            debouncer.expedite();
+            expect(that % debouncer.due(quiet, at(0)));
+
+            debouncer.clear();
+            expect(that % not debouncer.pending());
+            expect(that % not debouncer.due(quiet, at(1000)));
+
+            // clearing drops the urgency as well
+            debouncer.poke(at(1000));
+            expect(that % not debouncer.due(quiet, at(1010)));
+        };
+    };
+}
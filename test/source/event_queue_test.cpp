@@ -0,0 +1,433 @@
+#include <boost/ut.hpp>
+
+#include <glfw_cpp/event.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace ut = boost::ut;
+
+namespace ev = glfw_cpp::event;
+
+using glfw_cpp::Event;
+using glfw_cpp::EventDrops;
+using glfw_cpp::EventQueue;
+
+// events are told apart by the x coordinate of a `CursorMoved`
+Event cursor(int x)
+{
+    return ev::CursorMoved{ .x = static_cast<double>(x), .y = 0.0, .dx = 0.0, .dy = 0.0 };
+}
+
+// critical event carrying a sequence number in its scancode
+Event key_release(int seq)
+{
+    return ev::KeyPressed{
+        .key      = glfw_cpp::KeyCode::A,
+        .scancode = seq,
+        .state    = glfw_cpp::KeyState::Release,
+        .mods     = {},
+    };
+}
+
+// sequence number of a cursor or key release event made by the functions above
+int seq_of(const Event& event)
+{
+    if (auto* key = event.get_if<ev::KeyPressed>()) {
+        return key->scancode;
+    }
+    return static_cast<int>(event.get<ev::CursorMoved>().x);
+}
+
+std::vector<int> cursors(const EventQueue& queue)
+{
+    auto xs = std::vector<int>{};
+    for (const auto& event : queue) {
+        xs.push_back(static_cast<int>(event.get<ev::CursorMoved>().x));
+    }
+    return xs;
+}
+
+int main()
+{
+    using ut::expect, ut::that;
+    using namespace ut::literals;
+    using namespace ut::operators;
+
+    namespace overflow = glfw_cpp::overflow;
+
+    [[maybe_unused]] ut::suite overflow_policy_tests = [] {
+        "push with a policy on a queue that is not full should not drop anything"_test = [] {
+            auto queue    = EventQueue{ 4 };
+            auto policies = {
+                overflow::Policy{ overflow::Overwrite{} },
+                overflow::Policy{ overflow::Reject{} },
+            };
+
+            for (const auto& policy : policies) {
+                queue.reset();
+                expect(that % not queue.push(cursor(1), policy).has_value());
+                expect(that % not queue.push(cursor(2), policy).has_value());
+                expect(that % queue.size() == 2ul);
+            }
+        };
+
+        "Overwrite should drop the oldest event"_test = [] {
+            auto queue = EventQueue{ 3 };
+            for (auto x : { 1, 2, 3 }) {
+                expect(that % not queue.push(cursor(x), overflow::Overwrite{}).has_value());
+            }
+
+            auto dropped = queue.push(cursor(4), overflow::Overwrite{});
+
+            expect(that % dropped.has_value());
+            expect(that % dropped->get<ev::CursorMoved>().x == 1.0);
+            expect(that % queue.capacity() == 3ul);
+            expect(that % cursors(queue) == std::vector{ 2, 3, 4 });
+        };
+
+        "Reject should drop the new event"_test = [] {
+            auto queue = EventQueue{ 3 };
+            for (auto x : { 1, 2, 3 }) {
+                expect(that % not queue.push(cursor(x), overflow::Reject{}).has_value());
+            }
+
+            auto dropped = queue.push(cursor(4), overflow::Reject{});
+
+            expect(that % dropped.has_value());
+            expect(that % dropped->get<ev::CursorMoved>().x == 4.0);
+            expect(that % cursors(queue) == std::vector{ 1, 2, 3 });
+        };
+
+        "Grow should double the capacity up to the bound then overwrite"_test = [] {
+            auto queue  = EventQueue{ 2 };
+            auto policy = overflow::Grow{ .max_capacity = 6 };
+
+            for (auto x : { 1, 2, 3 }) {
+                expect(that % not queue.push(cursor(x), policy).has_value());
+            }
+            expect(that % queue.capacity() == 4ul);
+
+            for (auto x : { 4, 5, 6 }) {
+                expect(that % not queue.push(cursor(x), policy).has_value());
+            }
+            expect(that % queue.capacity() == 6ul);
+            expect(that % cursors(queue) == std::vector{ 1, 2, 3, 4, 5, 6 });
+
+            auto dropped = queue.push(cursor(7), policy);
+
+            expect(that % dropped.has_value());
+            expect(that % dropped->get<ev::CursorMoved>().x == 1.0);
+            expect(that % queue.capacity() == 6ul);
+            expect(that % cursors(queue) == std::vector{ 2, 3, 4, 5, 6, 7 });
+        };
+
+        "Grow should keep the order of a wrapped queue"_test = [] {
+            auto queue = EventQueue{ 3 };
+            for (auto x : { 1, 2, 3 }) {
+                queue.push(cursor(x));
+            }
+            queue.pop();
+            queue.push(cursor(4));    // wraps around
+
+            expect(that % not queue.push(cursor(5), overflow::Grow{ .max_capacity = 8 }).has_value());
+            expect(that % queue.capacity() == 6ul);
+            expect(that % cursors(queue) == std::vector{ 2, 3, 4, 5 });
+        };
+    };
+
+    [[maybe_unused]] ut::suite type_index_tests = [] {
+        "the type index should agree with a scan of the queue"_test = [] {
+            auto indexed = EventQueue{ 8 };
+            auto scanned = EventQueue{ 8 };
+            indexed.set_type_index(true);
+
+            auto check = [&] {
+                expect(that % indexed.count<ev::CursorMoved>() == scanned.count<ev::CursorMoved>());
+                expect(that % indexed.count<ev::Scrolled>() == scanned.count<ev::Scrolled>());
+
+                auto* last_indexed = indexed.last<ev::CursorMoved>();
+                auto* last_scanned = scanned.last<ev::CursorMoved>();
+                expect(that % (last_indexed == nullptr) == (last_scanned == nullptr));
+                if (last_indexed and last_scanned) {
+                    expect(that % last_indexed->x == last_scanned->x);
+                }
+
+                auto xs_indexed = std::vector<double>{};
+                auto xs_scanned = std::vector<double>{};
+                for (const auto& e : indexed.of_type<ev::CursorMoved>()) {
+                    xs_indexed.push_back(e.x);
+                }
+                for (const auto& e : scanned.of_type<ev::CursorMoved>()) {
+                    xs_scanned.push_back(e.x);
+                }
+                expect(that % xs_indexed == xs_scanned);
+            };
+
+            auto rng = std::mt19937{ 42 };
+            for (auto i = 0; i < 1000; ++i) {
+                switch (auto op = rng() % 8; op) {
+                case 0: {
+                    indexed.pop();
+                    scanned.pop();
+                } break;
+                case 1: {
+                    auto capacity = 1 + rng() % 12;
+                    indexed.resize(capacity);
+                    scanned.resize(capacity);
+                } break;
+                default: {
+                    // a third of the pushes are another type
+                    auto event = op < 4 ? Event{ ev::Scrolled{ .dx = 0.0, .dy = 0.0 } } : cursor(i);
+                    indexed.push(Event{ event });
+                    scanned.push(std::move(event));
+                } break;
+                }
+                check();
+            }
+
+            indexed.reset();
+            expect(that % indexed.count<ev::CursorMoved>() == 0ul);
+            expect(that % (indexed.last<ev::CursorMoved>() == nullptr));
+        };
+
+        "enabling the type index on a filled queue should index the queued events"_test = [] {
+            auto queue = EventQueue{ 4 };
+            for (auto x : { 1, 2, 3, 4, 5 }) {
+                queue.push(cursor(x));
+            }
+            queue.set_type_index(true);
+
+            expect(that % queue.has_type_index());
+            expect(that % queue.count<ev::CursorMoved>() == 4ul);
+            expect(that % queue.last<ev::CursorMoved>()->x == 5.0);
+        };
+    };
+
+    [[maybe_unused]] ut::suite segment_tests = [] {
+        "segments of a queue that doesn't wrap should be the queue and an empty span"_test = [] {
+            auto queue = EventQueue{ 4 };
+            queue.push(cursor(1));
+            queue.push(cursor(2));
+
+            auto [front, wrapped] = queue.segments();
+            expect(that % front.size() == 2ul);
+            expect(that % wrapped.empty());
+        };
+
+        "segments of a wrapped queue should hold the events in queue order"_test = [] {
+            auto queue = EventQueue{ 4 };
+            for (auto x : { 1, 2, 3, 4, 5, 6 }) {
+                queue.push(cursor(x));
+            }
+
+            auto xs = std::vector<int>{};
+            for (auto segment : queue.segments()) {
+                for (const auto& event : segment) {
+                    xs.push_back(static_cast<int>(event.get<ev::CursorMoved>().x));
+                }
+            }
+
+            expect(that % queue.segments()[1].size() == 2ul);
+            expect(that % xs == std::vector{ 3, 4, 5, 6 });
+        };
+
+        "drain_into should move events in queue order and remove them"_test = [] {
+            auto queue = EventQueue{ 4 };
+            queue.set_type_index(true);
+            for (auto x : { 1, 2, 3, 4, 5 }) {
+                queue.push(cursor(x));
+            }
+
+            auto out = std::vector<Event>(3);
+            expect(that % queue.drain_into(out) == 3ul);
+            expect(that % out[0].get<ev::CursorMoved>().x == 2.0);
+            expect(that % out[2].get<ev::CursorMoved>().x == 4.0);
+            expect(that % cursors(queue) == std::vector{ 5 });
+            expect(that % queue.count<ev::CursorMoved>() == 1ul);
+
+            queue.push(cursor(6));
+            expect(that % queue.drain_into(out) == 2ul);
+            expect(that % out[1].get<ev::CursorMoved>().x == 6.0);
+            expect(that % queue.empty());
+            expect(that % queue.count<ev::CursorMoved>() == 0ul);
+            expect(that % queue.drain_into(out) == 0ul);
+        };
+    };
+
+    [[maybe_unused]] ut::suite priority_lane_tests = [] {
+        using glfw_cpp::PriorityLane;
+
+        "critical events should survive an overflow and be merged in push order"_test = [] {
+            auto queue = EventQueue{ 4 };
+            auto out   = EventQueue{ 4 };
+            auto lane  = PriorityLane{};
+
+            auto seq = 0;
+            for (auto i = 0; i < 10; ++i) {
+                lane.push(queue, cursor(++seq), overflow::Overwrite{});
+                if (i % 3 == 0) {
+                    lane.push(queue, key_release(++seq), overflow::Overwrite{});
+                }
+            }
+
+            lane.swap_merged(queue, out);
+
+            auto seqs = std::vector<int>{};
+            for (const auto& event : out) {
+                seqs.push_back(seq_of(event));
+            }
+
+            // only the last 4 cursors (9, 11, 12, 13) are left in the queue, the key releases are all kept
+            expect(that % seqs == std::vector{ 2, 6, 9, 10, 11, 12, 13, 14 });
+            expect(that % queue.empty());
+            expect(that % lane.empty());
+        };
+
+        "without critical events swap_merged should only swap"_test = [] {
+            auto queue = EventQueue{ 4 };
+            auto out   = EventQueue{ 2 };
+            auto lane  = PriorityLane{};
+
+            lane.push(queue, cursor(1), overflow::Overwrite{});
+            lane.swap_merged(queue, out);
+
+            expect(that % out.capacity() == 4ul);
+            expect(that % cursors(out) == std::vector{ 1 });
+            expect(that % queue.empty());
+        };
+
+        "a full lane should coalesce close and focus changes and drop the other events"_test = [] {
+            auto queue = EventQueue{ 4 };
+            auto out   = EventQueue{ 4 };
+            auto lane  = PriorityLane{};
+
+            lane.push(queue, ev::WindowFocused{ true }, overflow::Overwrite{});
+            lane.push(queue, ev::WindowClosed{}, overflow::Overwrite{});
+            for (auto seq = 1; lane.size() < PriorityLane::s_reserved; ++seq) {
+                lane.push(queue, key_release(seq), overflow::Overwrite{});
+            }
+
+            auto unfocused = lane.push(queue, ev::WindowFocused{ false }, overflow::Overwrite{});
+            auto closed    = lane.push(queue, ev::WindowClosed{}, overflow::Overwrite{});
+            expect(that % not unfocused.has_value() and not closed.has_value());
+
+            auto dropped = lane.push(queue, key_release(100), overflow::Overwrite{});
+            expect(dropped.has_value() and seq_of(*dropped) == 100);
+            expect(that % lane.size() == PriorityLane::s_reserved);
+
+            // the latest focus state took the place of the first one
+            lane.swap_merged(queue, out);
+            expect(that % out.size() == PriorityLane::s_reserved);
+            expect(that % (*out.begin()).get<ev::WindowFocused>().focused == false);
+            expect(that % out.count<ev::WindowClosed>() == 1ul);
+            expect(that % lane.empty());
+        };
+
+        "no critical event should be lost under a 10 kHz motion flood"_test = [] {
+            using Clock = std::chrono::steady_clock;
+
+            auto mutex = std::mutex{};
+            auto queue = EventQueue{ 128 };
+            auto lane  = PriorityLane{};
+            auto done  = std::atomic<bool>{ false };
+            auto seq   = 0;    // written by the producer only
+            auto keys  = 0;
+
+            // 10 cursor events per millisecond and a key release every 5 ms for half a second
+            auto producer = std::jthread{ [&] {
+                auto next = Clock::now();
+                for (auto ms = 0; ms < 500; ++ms) {
+                    {
+                        auto lock = std::scoped_lock{ mutex };
+                        for (auto i = 0; i < 10; ++i) {
+                            lane.push(queue, cursor(++seq), overflow::Overwrite{});
+                        }
+                        if (ms % 5 == 0) {
+                            lane.push(queue, key_release(++seq), overflow::Overwrite{});
+                            ++keys;
+                        }
+                    }
+                    next += std::chrono::milliseconds{ 1 };
+                    std::this_thread::sleep_until(next);
+                }
+                done = true;
+            } };
+
+            // render thread at 60 fps
+            auto front    = EventQueue{ 128 };
+            auto received = 0;
+            auto last_seq = 0;
+            auto ordered  = true;
+            auto flooded  = false;
+
+            auto consume = [&] {
+                {
+                    auto lock = std::scoped_lock{ mutex };
+                    flooded   = flooded or queue.full();
+                    lane.swap_merged(queue, front);
+                }
+                for (const auto& event : front) {
+                    ordered  = ordered and seq_of(event) > last_seq;
+                    last_seq = seq_of(event);
+                    received += event.is<ev::KeyPressed>() ? 1 : 0;
+                }
+            };
+
+            while (not done) {
+                consume();
+                std::this_thread::sleep_for(std::chrono::milliseconds{ 16 });
+            }
+            producer.join();
+            consume();
+
+            expect(that % flooded);    // the flood did overflow the queue
+            expect(that % ordered);
+            expect(that % keys == 100);
+            expect(that % received == keys);
+        };
+    };
+
+    [[maybe_unused]] ut::suite event_drops_tests = [] {
+        "EventDrops should count dropped events per type"_test = [] {
+            auto drops = EventDrops{};
+            expect(that % drops.total() == 0ul);
+
+            drops.record(cursor(1));
+            drops.record(cursor(2));
+            drops.record(ev::KeyPressed{});
+
+            expect(that % drops.count<ev::CursorMoved>() == 2ul);
+            expect(that % drops.count<ev::KeyPressed>() == 1ul);
+            expect(that % drops.count<ev::Scrolled>() == 0ul);
+            expect(that % drops.total() == 3ul);
+        };
+    };
+
+    [[maybe_unused]] ut::suite coalesce_tests = [] {
+        "coalesced resizes should keep the latest size and the total change"_test = [] {
+            // 800x600 -> 820x590 -> 850x640 delivered as one event, the values are width, height, width_change,
+            // and height_change
+            auto pending = ev::WindowResized{ 820, 590, 20, -10 };
+            ev::coalesce(pending, { 850, 640, 30, 50 });
+
+            expect(that % pending.width == 850);
+            expect(that % pending.height == 640);
+            expect(that % pending.width_change == 50);
+            expect(that % pending.height_change == 40);
+
+            // a change and its reversal cancel out
+            auto frame = ev::FramebufferResized{ 10, 10, 10, 10 };
+            ev::coalesce(frame, { 0, 0, -10, -10 });
+
+            expect(that % frame.width == 0);
+            expect(that % frame.width_change == 0);
+            expect(that % frame.height_change == 0);
+        };
+    };
+}
@@ -0,0 +1,142 @@
+#include <boost/ut.hpp>
+
+#include <glfw_cpp/extension_set.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#if defined(_WIN32)
+    #define GLFW_CPP_GL_APIENTRY __stdcall
+#else
+    #define GLFW_CPP_GL_APIENTRY
+#endif
+
+namespace ut = boost::ut;
+namespace gl = glfw_cpp::gl;
+
+constexpr unsigned int GL_VERSION        = 0x1F02;
+constexpr unsigned int GL_EXTENSIONS     = 0x1F03;
+constexpr unsigned int GL_NUM_EXTENSIONS = 0x821D;
+
+// the context seen through the fake loader, either as a version string with an extension string (before 3.0)
+// or as an indexed extension list
+std::string              g_version;
+std::string              g_extensions;
+std::vector<std::string> g_indexed;
+int                      g_enumerations = 0;    // calls to glGetString(GL_VERSION), once per set
+
+const unsigned char* GLFW_CPP_GL_APIENTRY fake_get_string(unsigned int name)
+{
+    if (name == GL_VERSION) {
+        ++g_enumerations;
+        return reinterpret_cast<const unsigned char*>(g_version.c_str());
+    }
+    if (name == GL_EXTENSIONS) {
+        return reinterpret_cast<const unsigned char*>(g_extensions.c_str());
+    }
+    return nullptr;
+}
+
+const unsigned char* GLFW_CPP_GL_APIENTRY fake_get_stringi(unsigned int name, unsigned int index)
+{
+    if (name != GL_EXTENSIONS or index >= g_indexed.size()) {
+        return nullptr;
+    }
+    return reinterpret_cast<const unsigned char*>(g_indexed[index].c_str());
+}
+
+void GLFW_CPP_GL_APIENTRY fake_get_integerv(unsigned int name, int* value)
+{
+    if (name == GL_NUM_EXTENSIONS) {
+        *value = static_cast<int>(g_indexed.size());
+    }
+}
+
+gl::Proc fake_loader(const char* name)
+{
+    if (std::strcmp(name, "glGetString") == 0) {
+        return reinterpret_cast<gl::Proc>(&fake_get_string);
+    }
+    if (std::strcmp(name, "glGetStringi") == 0) {
+        return reinterpret_cast<gl::Proc>(&fake_get_stringi);
+    }
+    if (std::strcmp(name, "glGetIntegerv") == 0) {
+        return reinterpret_cast<gl::Proc>(&fake_get_integerv);
+    }
+    return nullptr;
+}
+
+// the sets are keyed by window, the fake contexts are never dereferenced
+GLFWwindow* fake_context(std::uintptr_t value)
+{
+    return reinterpret_cast<GLFWwindow*>(value * 16);
+}
+
+int main()
+{
+    using ut::expect, ut::that;
+    using namespace ut::literals;
+    using namespace ut::operators;
+
+    [[maybe_unused]] ut::suite extension_set_tests = [] {
+        "an extension string should be split on spaces"_test = [] {
+            g_version    = "2.1 Mesa 24.0";
+            g_extensions = " GL_ARB_multitexture  GL_EXT_blend_minmax GL_ARB_vertex_buffer_object ";
+
+            auto set = gl::ExtensionSet{ fake_loader };
+
+            expect(that % set.size() == 3ul);
+            expect(set.contains("GL_ARB_multitexture"));
+            expect(set.contains("GL_ARB_vertex_buffer_object"));
+
+            // a lookup matches whole names only, unlike a substring search of the string
+            expect(not set.contains("GL_ARB_vertex"));
+            expect(not set.contains("GL_EXT_blend"));
+            expect(not set.contains("GL_ARB_compute_shader"));
+        };
+
+        "the indexed list should be used from version 3.0"_test = [] {
+            g_version    = "OpenGL ES 3.2 Mesa 24.0";
+            g_extensions = "GL_OES_ignored";
+            g_indexed    = { "GL_EXT_color_buffer_float", "GL_OES_texture_3D", "GL_KHR_debug" };
+
+            auto set = gl::ExtensionSet{ fake_loader };
+
+            expect(that % set.size() == 3ul);
+            expect(set.contains("GL_KHR_debug"));
+            expect(set.contains("GL_OES_texture_3D"));
+            expect(not set.contains("GL_OES_ignored"));
+        };
+
+        "the set of a context should be built once until it is forgotten"_test = [] {
+            g_version      = "4.6.0 NVIDIA 550.54";
+            g_indexed      = { "GL_ARB_direct_state_access" };
+            g_enumerations = 0;
+
+            auto first  = fake_context(1);
+            auto second = fake_context(2);
+
+            const auto& set = gl::current_extensions(first, fake_loader);
+            expect(&gl::current_extensions(first, fake_loader) == &set);
+            expect(that % g_enumerations == 1);
+
+            // a context switch goes through the shared sets, not the per-thread fast path
+            const auto& other = gl::current_extensions(second, fake_loader);
+            expect(&other != &set);
+            expect(&gl::current_extensions(first, fake_loader) == &set);
+            expect(that % g_enumerations == 2);
+
+            // the fast path of the thread is invalidated, the new set sees the new extensions
+            g_indexed.push_back("GL_KHR_parallel_shader_compile");
+            gl::forget_extensions(first);
+            const auto& rebuilt = gl::current_extensions(first, fake_loader);
+            expect(that % g_enumerations == 3);
+            expect(rebuilt.contains("GL_KHR_parallel_shader_compile"));
+
+            gl::forget_extensions(first);
+            gl::forget_extensions(second);
+        };
+    };
+}
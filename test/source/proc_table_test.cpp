@@ -0,0 +1,105 @@
+#include <boost/ut.hpp>
+
+#include <glfw_cpp/proc_table.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <latch>
+#include <memory>
+#include <thread>
+
+namespace ut = boost::ut;
+namespace gl = glfw_cpp::gl;
+
+void fake_proc() { }
+
+std::atomic<int> g_loads = 0;          // names resolved by `fake_loader`
+std::latch*      g_race  = nullptr;    // holds every racing thread in the loader until all of them got there
+
+// resolves every name except the ones starting with "missing", no context needed
+gl::Proc fake_loader(const char* name)
+{
+    g_loads.fetch_add(1, std::memory_order::relaxed);
+    if (g_race != nullptr) {
+        g_race->arrive_and_wait();
+    }
+    return std::strncmp(name, "missing", 7) != 0 ? &fake_proc : nullptr;
+}
+
+// the lists are keyed by address, so they are static like the ones of an application
+constexpr const char* g_names[]  = { "glClear", "missingProc", "glDrawArrays" };
+constexpr const char* g_other[]  = { "glClear", "missingProc", "glDrawArrays" };
+constexpr const char* g_single[] = { "glFlush" };
+
+gl::ContextSignature signature(const char* renderer)
+{
+    return { .vendor = "fake", .renderer = renderer, .version = "4.6.0", .profile_mask = 1 };
+}
+
+int main()
+{
+    using ut::expect, ut::that;
+    using namespace ut::literals;
+    using namespace ut::operators;
+
+    [[maybe_unused]] ut::suite proc_table_tests = [] {
+        "a table should resolve every name in order"_test = [] {
+            auto table = gl::ProcTable{ signature("a"), g_names, fake_loader };
+
+            expect(that % table.size() == 3ul);
+            expect(that % table.missing() == 1ul);
+            expect(table[0] == &fake_proc and table[1] == nullptr and table[2] == &fake_proc);
+            expect(table.names().data() == g_names);
+            expect(table.signature() == signature("a"));
+        };
+
+        "tables should be shared by the contexts with the same signature and list"_test = [] {
+            gl::clear_proc_table_cache();
+            g_loads = 0;
+
+            auto first = gl::load_proc_table(g_names, signature("a"), fake_loader);
+            auto again = gl::load_proc_table(g_names, signature("a"), fake_loader);
+            expect(first == again);
+            expect(that % g_loads.load() == 3);
+
+            // another driver, or another list with the same names, is resolved again
+            auto other_driver = gl::load_proc_table(g_names, signature("b"), fake_loader);
+            auto other_list   = gl::load_proc_table(g_other, signature("a"), fake_loader);
+            expect(other_driver != first and other_list != first);
+            expect(that % g_loads.load() == 9);
+
+            // the tables handed out outlive the cache
+            gl::clear_proc_table_cache();
+            auto fresh = gl::load_proc_table(g_names, signature("a"), fake_loader);
+            expect(fresh != first);
+            expect(first->missing() == 1ul);
+        };
+
+        "threads racing on a missing table should all get the first stored one"_test = [] {
+            gl::clear_proc_table_cache();
+
+            // both threads miss the cache and resolve the list before either stores its table
+            auto race = std::latch{ 2 };
+            g_race    = &race;
+
+            auto tables = std::array<std::shared_ptr<const gl::ProcTable>, 2>{};
+            auto load   = [&](std::size_t i) {
+                tables[i] = gl::load_proc_table(g_single, signature("a"), fake_loader);
+            };
+            {
+                auto first  = std::jthread{ load, 0 };
+                auto second = std::jthread{ load, 1 };
+            }
+            g_race = nullptr;
+
+            expect(tables[0] != nullptr and tables[0] == tables[1]);
+
+            // the losing table was not stored either
+            auto loads = g_loads.load();
+            expect(gl::load_proc_table(g_single, signature("a"), fake_loader) == tables[0]);
+            expect(that % g_loads.load() == loads);
+        };
+    };
+}
@@ -0,0 +1,185 @@
+#include <boost/ut.hpp>
+
+#include <glfw_cpp/capture.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace ut     = boost::ut;
+namespace detail = glfw_cpp::capture::detail;
+
+struct Image
+{
+    std::uint32_t          width  = 0;
+    std::uint32_t          height = 0;
+    std::vector<std::byte> pixels;    // RGBA8, bottom-to-top rows like glReadPixels
+};
+
+Image make_image(std::uint32_t width, std::uint32_t height, auto fn)
+{
+    auto image = Image{ width, height, std::vector<std::byte>(std::size_t{ width } * height * 4) };
+    for (auto i = std::size_t{ 0 }; i < image.pixels.size(); ++i) {
+        image.pixels[i] = static_cast<std::byte>(fn(i / 4, i % 4));
+    }
+    return image;
+}
+
+// reference decoder written from the specification, returns top-to-bottom rows
+struct Decoded
+{
+    std::uint32_t          width      = 0;
+    std::uint32_t          height     = 0;
+    std::uint8_t           channels   = 0;
+    std::uint8_t           colorspace = 0;
+    bool                   end_marker = false;
+    std::vector<std::byte> pixels;
+};
+
+Decoded decode_qoi(const std::vector<std::byte>& data)
+{
+    auto pos  = std::size_t{ 0 };
+    auto read = [&] { return pos < data.size() ? static_cast<std::uint8_t>(data[pos++]) : std::uint8_t{}; };
+    auto read32 = [&] {
+        auto value = std::uint32_t{};
+        for (auto i = 0; i < 4; ++i) {
+            value = value << 8 | read();
+        }
+        return value;
+    };
+
+    auto decoded = Decoded{};
+    if (read32() != 0x716F6966) {    // "qoif"
+        return decoded;
+    }
+    decoded.width      = read32();
+    decoded.height     = read32();
+    decoded.channels   = read();
+    decoded.colorspace = read();
+
+    auto index = std::array<std::array<std::uint8_t, 4>, 64>{};
+    auto px    = std::array<std::uint8_t, 4>{ 0, 0, 0, 255 };
+    auto run   = 0;
+
+    const auto total = std::size_t{ decoded.width } * decoded.height;
+    for (auto i = std::size_t{ 0 }; i < total; ++i) {
+        if (run > 0) {
+            --run;
+        } else if (auto b1 = read(); b1 == 0xFE) {
+            px[0] = read(), px[1] = read(), px[2] = read();
+        } else if (b1 == 0xFF) {
+            px[0] = read(), px[1] = read(), px[2] = read(), px[3] = read();
+        } else if ((b1 & 0xC0) == 0x00) {
+            px = index[b1];
+        } else if ((b1 & 0xC0) == 0x40) {
+            px[0] = static_cast<std::uint8_t>(px[0] + ((b1 >> 4) & 0x03) - 2);
+            px[1] = static_cast<std::uint8_t>(px[1] + ((b1 >> 2) & 0x03) - 2);
+            px[2] = static_cast<std::uint8_t>(px[2] + (b1 & 0x03) - 2);
+        } else if ((b1 & 0xC0) == 0x80) {
+            auto b2 = read();
+            auto vg = (b1 & 0x3F) - 32;
+            px[0]   = static_cast<std::uint8_t>(px[0] + vg - 8 + ((b2 >> 4) & 0x0F));
+            px[1]   = static_cast<std::uint8_t>(px[1] + vg);
+            px[2]   = static_cast<std::uint8_t>(px[2] + vg - 8 + (b2 & 0x0F));
+        } else {
+            run = b1 & 0x3F;
+        }
+
+        index[(px[0] * 3 + px[1] * 5 + px[2] * 7 + px[3] * 11) % 64] = px;
+        for (auto c : px) {
+            decoded.pixels.push_back(static_cast<std::byte>(c));
+        }
+    }
+
+    static constexpr auto padding = std::array<std::uint8_t, 8>{ 0, 0, 0, 0, 0, 0, 0, 1 };
+    decoded.end_marker = pos + padding.size() == data.size();
+    for (auto byte : padding) {
+        decoded.end_marker = decoded.end_marker and read() == byte;
+    }
+
+    return decoded;
+}
+
+std::vector<std::byte> flip(const Image& image)
+{
+    const auto stride  = std::size_t{ image.width } * 4;
+    auto       flipped = std::vector<std::byte>(image.pixels.size());
+    for (auto y = std::size_t{ 0 }; y < image.height; ++y) {
+        auto src = image.pixels.begin() + static_cast<std::ptrdiff_t>((image.height - 1 - y) * stride);
+        std::copy_n(src, stride, flipped.begin() + static_cast<std::ptrdiff_t>(y * stride));
+    }
+    return flipped;
+}
+
+std::vector<std::byte> encode(const Image& image)
+{
+    auto data = std::vector<std::byte>(detail::qoi_max_size(image.width, image.height));
+    auto size = detail::encode_qoi(image.pixels.data(), image.width, image.height, data.data());
+    data.resize(size);
+    return data;
+}
+
+int main()
+{
+    using ut::expect, ut::that;
+    using namespace ut::literals;
+    using namespace ut::operators;
+
+    [[maybe_unused]] ut::suite qoi_tests = [] {
+        "an encoded image should have a valid header and end marker"_test = [] {
+            auto image   = make_image(7, 3, [](auto px, auto c) { return px * 13 + c; });
+            auto decoded = decode_qoi(encode(image));
+
+            expect(that % decoded.width == 7u);
+            expect(that % decoded.height == 3u);
+            expect(that % decoded.channels == 4);
+            expect(that % decoded.colorspace == 0);
+            expect(that % decoded.end_marker);
+        };
+
+        "images should round-trip through every chunk type"_test = [] {
+            auto rng    = std::mt19937{ 42 };
+            auto images = std::vector<Image>{
+                // runs: longer than a single run chunk, and ending on a run
+                make_image(200, 3, [](auto, auto c) { return c == 3 ? 255 : 0; }),
+                make_image(1, 1, [](auto, auto c) { return c == 3 ? 255 : 0; }),
+                // small and medium differences
+                make_image(64, 16, [](auto px, auto c) { return c == 3 ? 255 : (px + c) % 256; }),
+                make_image(64, 16, [](auto px, auto c) { return c == 3 ? 255 : (px * (c + 9)) % 256; }),
+                // a palette hitting the index
+                make_image(33, 17, [](auto px, auto c) { return (px % 5) * 50 + c; }),
+                // noise, alpha included
+                make_image(37, 23, [&](auto, auto) { return rng() % 256; }),
+            };
+
+            for (const auto& image : images) {
+                auto data    = encode(image);
+                auto decoded = decode_qoi(data);
+
+                expect(that % data.size() <= detail::qoi_max_size(image.width, image.height));
+                expect(that % decoded.end_marker);
+                expect(decoded.pixels == flip(image)) << "decoded pixels differ from the source";
+            }
+        };
+
+        "a flat image should compress to runs"_test = [] {
+            auto image = make_image(256, 256, [](auto, auto c) { return c == 3 ? 255 : 0; });
+            auto data  = encode(image);
+
+            // header, ceil(65536 / 62) run chunks, end marker
+            expect(that % data.size() == 14 + (65536 + 61) / 62 + 8);
+        };
+
+        "raw frames should be flipped to top-to-bottom rows"_test = [] {
+            auto image = make_image(5, 4, [](auto px, auto c) { return px * 4 + c; });
+            auto data  = std::vector<std::byte>(image.pixels.size());
+            auto size  = detail::encode_raw(image.pixels.data(), image.width, image.height, data.data());
+
+            expect(that % size == image.pixels.size());
+            expect(data == flip(image));
+        };
+    };
+}
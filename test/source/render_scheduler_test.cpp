@@ -0,0 +1,173 @@
+#include <boost/ut.hpp>
+
+#include <glfw_cpp/instance.hpp>
+#include <glfw_cpp/render_scheduler.hpp>
+#include <glfw_cpp/window.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ut = boost::ut;
+
+using glfw_cpp::EventQueue;
+using glfw_cpp::RenderScheduler;
+using glfw_cpp::Window;
+
+using Clock = RenderScheduler::Clock;
+using std::chrono::milliseconds;
+
+// a flag raised by one thread and awaited by another, the wait gives up instead of hanging the test
+class Signal
+{
+public:
+    void set()
+    {
+        {
+            std::scoped_lock lock{ m_mutex };
+            m_set = true;
+        }
+        m_cv.notify_all();
+    }
+
+    bool wait()
+    {
+        std::unique_lock lock{ m_mutex };
+        return m_cv.wait_for(lock, std::chrono::seconds{ 5 }, [&] { return m_set; });
+    }
+
+private:
+    std::mutex              m_mutex;
+    std::condition_variable m_cv;
+    bool                    m_set = false;
+};
+
+int main()
+{
+    using ut::expect, ut::that;
+    using namespace ut::literals;
+    using namespace ut::operators;
+
+    // the null platform is always available; windows without a context are scheduled without migration
+    auto glfw = glfw_cpp::init({ .platform = glfw_cpp::hint::Platform::Null });
+    glfw->apply_hints({ .api = glfw_cpp::api::NoApi{} });
+
+    "an idle thread should steal the ready jobs of a busy one"_test = [&] {
+        auto blocker = glfw->create_window(64, 64, "blocker");
+        auto spawner = glfw->create_window(64, 64, "spawner");
+        auto first   = glfw->create_window(64, 64, "first");
+        auto second  = glfw->create_window(64, 64, "second");
+
+        auto blocker_running = Signal{};
+        auto blocker_release = Signal{};
+        auto holder_running  = Signal{};
+        auto other_rendered  = Signal{};
+
+        auto pair_started   = std::atomic<int>{ 0 };
+        auto blocker_thread = std::thread::id{};
+        auto holder_thread  = std::thread::id{};
+        auto other_thread   = std::thread::id{};
+
+        auto scheduler = RenderScheduler{ 2 };
+
+        // 1. one thread is held by the blocker
+        scheduler.add(
+            blocker,
+            [&, frame = 0](Window&, const EventQueue&) mutable {
+                if (frame++ == 0) {
+                    blocker_thread = std::this_thread::get_id();
+                    blocker_running.set();
+                    blocker_release.wait();
+                }
+            },
+            1.0
+        );
+        expect(blocker_running.wait()) << "the blocker was never rendered";
+
+        // 2. the other thread renders the spawner, then releases both new jobs into its own ring at once and
+        //    gets held by whichever it renders first
+        auto render_pair = [&, frame = 0](Window&, const EventQueue&) mutable {
+            if (frame++ != 0) {
+                return;
+            }
+            if (pair_started.fetch_add(1) == 0) {
+                holder_thread = std::this_thread::get_id();
+                holder_running.set();
+                other_rendered.wait();
+            } else {
+                other_thread = std::this_thread::get_id();
+                other_rendered.set();
+            }
+        };
+        scheduler.add(
+            spawner,
+            [&, frame = 0](Window&, const EventQueue&) mutable {
+                if (frame++ == 0) {
+                    scheduler.add(first, render_pair);
+                    scheduler.add(second, render_pair);
+                }
+            },
+            1.0
+        );
+
+        // 3. the other job waits in the ring of a held thread, only a steal by the released thread can run it
+        expect(holder_running.wait()) << "neither job of the pair was rendered";
+        blocker_release.set();
+        expect(other_rendered.wait()) << "the other job was never stolen";
+
+        expect(that % scheduler.stats().steals >= 1u);
+        expect(other_thread == blocker_thread) << "the job was not rendered by the released thread";
+        expect(holder_thread != blocker_thread);
+    };
+
+    "parked windows should wait for their deadline"_test = [&] {
+        auto fast = glfw->create_window(64, 64, "fast");
+        auto slow = glfw->create_window(64, 64, "slow");
+
+        auto mutex       = std::mutex{};
+        auto fast_frames = std::vector<Clock::time_point>{};
+        auto slow_frames = std::vector<Clock::time_point>{};
+
+        auto record = [&](std::vector<Clock::time_point>& frames) {
+            return [&](Window&, const EventQueue&) {
+                std::scoped_lock lock{ mutex };
+                frames.push_back(Clock::now());
+            };
+        };
+
+        // a single thread, so nothing is stolen and every frame comes out of the parked heap
+        auto start     = Clock::now();
+        auto scheduler = RenderScheduler{ 1 };
+        scheduler.add(fast, record(fast_frames), 20.0);    // every 50 ms
+        scheduler.add(slow, record(slow_frames), 8.0);     // every 125 ms
+
+        std::this_thread::sleep_for(milliseconds{ 400 });
+
+        fast.request_close();
+        slow.request_close();
+        scheduler.wait();
+        expect(that % scheduler.active() == 0u);
+
+        std::scoped_lock lock{ mutex };
+        expect(that % fast_frames.size() >= 2u);
+        expect(that % slow_frames.size() >= 2u);
+        expect(that % fast_frames.size() > slow_frames.size());
+
+        auto not_early = [&](const std::vector<Clock::time_point>& frames, milliseconds period) {
+            for (auto i = 0u; i < frames.size(); ++i) {
+                if (frames[i] - start < period * i) {
+                    return false;
+                }
+            }
+            return true;
+        };
+        expect(not_early(fast_frames, milliseconds{ 50 })) << "a frame was rendered before its deadline";
+        expect(not_early(slow_frames, milliseconds{ 125 })) << "a frame was rendered before its deadline";
+
+        expect(that % scheduler.stats().steals == 0u);
+        expect(that % scheduler.stats().frames == fast_frames.size() + slow_frames.size());
+    };
+}
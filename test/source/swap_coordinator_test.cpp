@@ -0,0 +1,87 @@
+#include <boost/ut.hpp>
+
+#include <glfw_cpp/instance.hpp>
+#include <glfw_cpp/swap_coordinator.hpp>
+#include <glfw_cpp/window.hpp>
+
+#include <chrono>
+#include <utility>
+#include <vector>
+
+namespace ut = boost::ut;
+
+using glfw_cpp::SwapCoordinator;
+using glfw_cpp::Window;
+
+using Clock = SwapCoordinator::Clock;
+using std::chrono::milliseconds;
+
+int main()
+{
+    using ut::expect, ut::that;
+    using namespace ut::literals;
+    using namespace ut::operators;
+
+    // the null platform is always available; the windows never need a context since nothing is swapped
+    auto glfw = glfw_cpp::init({ .platform = glfw_cpp::hint::Platform::Null });
+    glfw->apply_hints({ .api = glfw_cpp::api::NoApi{} });
+
+    "windows should be due in deadline order with the display-rate window last"_test = [&] {
+        auto display = glfw->create_window(64, 64, "display");
+        auto fast    = glfw->create_window(64, 64, "fast");
+        auto slow    = glfw->create_window(64, 64, "slow");
+
+        auto start       = Clock::now();
+        auto coordinator = SwapCoordinator{};
+        coordinator.add(display);
+        coordinator.add(slow, 4.0);     // every 250 ms
+        coordinator.add(fast, 10.0);    // every 100 ms
+
+        // everything is due on the first frame, the window presenting every frame takes the vsync
+        expect(coordinator.schedule() == std::vector<Window*>{ &slow, &fast, &display });
+
+        // the rate-limited windows are not due again yet
+        expect(coordinator.schedule() == std::vector<Window*>{ &display });
+
+        // without a display-rate window the coordinator sleeps until the nearest deadline
+        display.request_close();
+
+        auto expected = std::vector<std::pair<Window*, milliseconds>>{
+            { &fast, milliseconds{ 100 } },
+            { &fast, milliseconds{ 200 } },
+            { &slow, milliseconds{ 250 } },
+            { &fast, milliseconds{ 300 } },
+        };
+        for (auto [window, deadline] : expected) {
+            expect(coordinator.schedule() == std::vector<Window*>{ window });
+            expect(Clock::now() - start >= deadline) << "a window was due before its deadline";
+        }
+
+        // nothing left to render once every window should close
+        fast.request_close();
+        slow.request_close();
+        expect(that % coordinator.schedule().empty());
+    };
+
+    "a target rate change should move the window to or from the display-rate windows"_test = [&] {
+        auto first  = glfw->create_window(64, 64, "first");
+        auto second = glfw->create_window(64, 64, "second");
+
+        auto coordinator = SwapCoordinator{};
+        coordinator.add(first);
+        coordinator.add(second, 1.0);
+
+        expect(coordinator.schedule() == std::vector<Window*>{ &second, &first });
+        expect(coordinator.schedule() == std::vector<Window*>{ &first });
+
+        // re-adding only updates the rate
+        coordinator.add(second);
+        coordinator.set_target_rate(first, 1.0);
+        expect(that % coordinator.size() == 2u);
+        expect(coordinator.schedule() == std::vector<Window*>{ &first, &second });
+        expect(coordinator.schedule() == std::vector<Window*>{ &second });
+
+        coordinator.remove(second);
+        expect(that % coordinator.size() == 1u);
+    };
+}
@@ -0,0 +1,217 @@
+#include <boost/ut.hpp>
+
+#include <glfw_cpp/task.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <future>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ut   = boost::ut;
+namespace task = glfw_cpp::task;
+
+// every allocation of the test is counted, to check the paths that must not allocate
+std::atomic<std::size_t> g_allocations = 0;
+
+void* operator new(std::size_t size)
+{
+    g_allocations.fetch_add(1, std::memory_order::relaxed);
+    if (auto* ptr = std::malloc(size != 0 ? size : 1)) {
+        return ptr;
+    }
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+// stands in for Instance::submit_task, the test thread plays the main thread
+template <typename T, typename Fn>
+task::Future<T> submit(std::vector<std::thread>& main_thread, Fn fn)
+{
+    auto state  = task::detail::Ref<T>::make();
+    auto future = task::Future<T>{ state };
+
+    main_thread.emplace_back([state = std::move(state), fn]() mutable { state->run(fn); });
+
+    return future;
+}
+
+// same as Instance::submit_task, with the queue run by the test itself
+template <typename Fn>
+task::Future<task::ResultOf<Fn>> enqueue(std::vector<task::Function>& queue, Fn fn)
+{
+    using T = task::ResultOf<Fn>;
+
+    auto state  = task::detail::Ref<T>::make();
+    auto future = task::Future<T>{ state };
+
+    queue.emplace_back(task::detail::Job<T, Fn>{ std::move(state), std::move(fn) });
+
+    return future;
+}
+
+// like Instance::run_tasks, the rest of the batch is dropped if a task throws
+void run_batch(std::vector<task::Function> batch)
+{
+    for (auto& function : batch) {
+        function();
+    }
+}
+
+void run_all(std::vector<task::Function>& queue)
+{
+    for (auto& function : queue) {
+        function();
+    }
+    queue.clear();
+}
+
+int main()
+{
+    using ut::expect, ut::that, ut::throws;
+    using namespace ut::literals;
+    using namespace ut::operators;
+
+    [[maybe_unused]] ut::suite task_tests = [] {
+        "a future should get the result of its task"_test = [] {
+            auto threads = std::vector<std::thread>{};
+
+            auto number = submit<int>(threads, [] { return 42; });
+            auto text   = submit<std::string>(threads, [] { return std::string{ "main" }; });
+            auto none   = submit<void>(threads, [] {});
+
+            expect(that % number.get() == 42);
+            expect(that % text.get() == std::string{ "main" });
+            none.get();
+
+            expect(that % not number.valid());
+            expect(that % not text.valid());
+            expect(that % not none.valid());
+
+            for (auto& thread : threads) {
+                thread.join();
+            }
+        };
+
+        "a future should rethrow the exception of its task"_test = [] {
+            auto threads = std::vector<std::thread>{};
+            auto future  = submit<int>(threads, []() -> int { throw std::runtime_error{ "task" }; });
+
+            expect(throws<std::runtime_error>([&] { future.get(); }));
+            threads.front().join();
+        };
+
+        "a released state should be reused clean"_test = [] {
+            auto state   = task::detail::Ref<int>::make();
+            auto address = state.operator->();
+            auto failed  = task::Future<int>{ state };
+
+            auto thrower = []() -> int { throw std::runtime_error{ "task" }; };
+            state->run(thrower);
+            state = {};
+            expect(throws<std::runtime_error>([&] { failed.get(); }));
+
+            // the state of the failed task is handed out again, without its result
+            auto next = task::detail::Ref<int>::make();
+            expect(next.operator->() == address) << "the state was not taken from the pool";
+            expect(that % not next->ready.load());
+            expect(that % not next->value.has_value());
+            expect(that % not next->exception);
+        };
+
+        "submitting a small task should not allocate once warmed up"_test = [] {
+            auto queue = std::vector<task::Function>{};
+            queue.reserve(8);
+
+            // the first round fills the pool
+            auto warm_up = enqueue(queue, [] { return 1; });
+            run_all(queue);
+            expect(that % warm_up.get() == 1);
+
+            auto before = g_allocations.load();
+            auto future = enqueue(queue, [value = 2] { return value; });
+            expect(that % queue.back().is_inline());
+            run_all(queue);
+            auto result = future.get();
+            auto after  = g_allocations.load();
+
+            expect(that % result == 2);
+            expect(that % after == before) << "allocations made by a pooled submit";
+        };
+
+        "a function should hold large and move-only callables"_test = [] {
+            auto sum = 0;
+
+            auto big   = std::array<int, 32>{ 1, 2, 3 };
+            auto large = task::Function{ [&sum, big] { sum += big[0] + big[1] + big[2]; } };
+            expect(that % not large.is_inline());
+
+            auto owned  = std::make_unique<int>(4);
+            auto unique = task::Function{ [&sum, owned = std::move(owned)] { sum += *owned; } };
+            expect(that % unique.is_inline());
+
+            // moving keeps the callables usable, the moved-from functions are empty
+            auto queue = std::vector<task::Function>{};
+            queue.push_back(std::move(large));
+            queue.push_back(std::move(unique));
+            expect(that % not large and not unique);
+
+            run_all(queue);
+            expect(that % sum == 10);
+        };
+
+        "a task dropped before it ran should break its promise"_test = [] {
+            auto is_broken = [](const std::future_error& e) {
+                return e.code() == std::make_error_code(std::future_errc::broken_promise);
+            };
+
+            auto queue   = std::vector<task::Function>{};
+            auto dropped = enqueue(queue, [] { return 1; });
+            queue.clear();
+
+            expect(that % dropped.ready());
+            try {
+                dropped.get();
+                expect(false) << "the future of a dropped task got a value";
+            } catch (const std::future_error& e) {
+                expect(is_broken(e));
+            }
+
+            // the tasks after a throwing one are dropped, the ones before it keep their result
+            auto done = enqueue(queue, [] { return 2; });
+            queue.emplace_back([] { throw std::runtime_error{ "task" }; });
+            auto skipped = enqueue(queue, [] {});
+
+            expect(throws<std::runtime_error>([&] { run_batch(std::move(queue)); }));
+            expect(that % done.get() == 2);
+            expect(that % skipped.ready());
+            expect(throws<std::future_error>([&] { skipped.get(); }));
+        };
+
+        "futures dropped before their task ran should not leak their state"_test = [] {
+            auto threads = std::vector<std::thread>{};
+
+            for (auto i = 0; i < 200; ++i) {
+                [[maybe_unused]] auto dropped = submit<int>(threads, [i] { return i; });
+            }
+            for (auto& thread : threads) {
+                thread.join();
+            }
+        };
+    };
+}
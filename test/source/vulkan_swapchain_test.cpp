@@ -0,0 +1,500 @@
+#include <vulkan/vulkan.h>
+
+#include <boost/ut.hpp>
+
+#include <glfw_cpp/instance.hpp>
+#include <glfw_cpp/vulkan.hpp>
+#include <glfw_cpp/vulkan_swapchain.hpp>
+#include <glfw_cpp/window.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+namespace ut = boost::ut;
+namespace vk = glfw_cpp::vk;
+
+// the Vulkan entry points used by the test, resolved like vk::Swapchain does
+struct Functions
+{
+    // clang-format off
+    PFN_vkDestroyInstance                        destroy_instance        = nullptr;
+    PFN_vkEnumeratePhysicalDevices               enumerate_devices       = nullptr;
+    PFN_vkGetPhysicalDeviceProperties            get_properties          = nullptr;
+    PFN_vkGetPhysicalDeviceFeatures2             get_features            = nullptr;
+    PFN_vkGetPhysicalDeviceQueueFamilyProperties get_queue_families      = nullptr;
+    PFN_vkGetPhysicalDeviceSurfaceSupportKHR     get_surface_support     = nullptr;
+    PFN_vkEnumerateDeviceExtensionProperties     enumerate_extensions    = nullptr;
+    PFN_vkCreateDevice                           create_device           = nullptr;
+    PFN_vkGetDeviceProcAddr                      get_device_proc         = nullptr;
+    PFN_vkDestroySurfaceKHR                      destroy_surface         = nullptr;
+    PFN_vkDestroyDevice                          destroy_device          = nullptr;
+    PFN_vkGetDeviceQueue                         get_queue               = nullptr;
+    PFN_vkCreateSemaphore                        create_semaphore        = nullptr;
+    PFN_vkDestroySemaphore                       destroy_semaphore       = nullptr;
+    PFN_vkSignalSemaphore                        signal_semaphore        = nullptr;
+    PFN_vkGetSemaphoreCounterValue               get_counter_value       = nullptr;
+    PFN_vkCreateCommandPool                      create_command_pool     = nullptr;
+    PFN_vkDestroyCommandPool                     destroy_command_pool    = nullptr;
+    PFN_vkResetCommandPool                       reset_command_pool      = nullptr;
+    PFN_vkAllocateCommandBuffers                 allocate_command_buffer = nullptr;
+    PFN_vkBeginCommandBuffer                     begin_command_buffer    = nullptr;
+    PFN_vkEndCommandBuffer                       end_command_buffer      = nullptr;
+    PFN_vkCmdPipelineBarrier                     pipeline_barrier        = nullptr;
+    PFN_vkQueueSubmit                            queue_submit            = nullptr;
+    PFN_vkQueueWaitIdle                          queue_wait_idle         = nullptr;
+    // clang-format on
+};
+
+/**
+ * A Vulkan 1.2 device presenting to a Null platform window through `VK_EXT_headless_surface`, available on
+ * Mesa lavapipe without a display.
+ */
+struct Context
+{
+    Functions        fn;
+    VkInstance       instance        = VK_NULL_HANDLE;
+    VkPhysicalDevice physical_device = VK_NULL_HANDLE;
+    VkDevice         device          = VK_NULL_HANDLE;
+    VkSurfaceKHR     surface         = VK_NULL_HANDLE;
+    std::uint32_t    family          = 0;
+    VkQueue          queue           = VK_NULL_HANDLE;
+    VkSemaphore      acquired        = VK_NULL_HANDLE;
+    VkSemaphore      rendered        = VK_NULL_HANDLE;
+    VkSemaphore      timeline        = VK_NULL_HANDLE;
+    VkCommandPool    pool            = VK_NULL_HANDLE;
+    VkCommandBuffer  commands        = VK_NULL_HANDLE;
+
+    Context()                          = default;
+    Context(const Context&)            = delete;
+    Context& operator=(const Context&) = delete;
+
+    ~Context()
+    {
+        // the creation may have stopped at any point, so may the loading of the entry points
+        if (device != VK_NULL_HANDLE and fn.destroy_command_pool != nullptr) {
+            fn.destroy_command_pool(device, pool, nullptr);
+        }
+        if (device != VK_NULL_HANDLE and fn.destroy_semaphore != nullptr) {
+            fn.destroy_semaphore(device, acquired, nullptr);
+            fn.destroy_semaphore(device, rendered, nullptr);
+            fn.destroy_semaphore(device, timeline, nullptr);
+        }
+        if (device != VK_NULL_HANDLE and fn.destroy_device != nullptr) {
+            fn.destroy_device(device, nullptr);
+        }
+        if (surface != VK_NULL_HANDLE and fn.destroy_surface != nullptr) {
+            fn.destroy_surface(instance, surface, nullptr);
+        }
+        if (instance != VK_NULL_HANDLE and fn.destroy_instance != nullptr) {
+            fn.destroy_instance(instance, nullptr);
+        }
+    }
+
+    vk::SwapchainConfig config(std::uint32_t retire_after = 3, bool with_timeline = false) const
+    {
+        return {
+            .instance        = instance,
+            .physical_device = physical_device,
+            .device          = device,
+            .surface         = surface,
+            .queue_families  = { family },
+            .format          = { VK_FORMAT_B8G8R8A8_UNORM, VK_COLOR_SPACE_SRGB_NONLINEAR_KHR },
+            .usage           = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT,
+            .present_modes   = { VK_PRESENT_MODE_FIFO_KHR },
+            .timeline        = with_timeline ? timeline : VK_NULL_HANDLE,
+            .debounce        = std::chrono::milliseconds{ 0 },
+            .retire_after    = retire_after,
+            .min_images      = 2,
+        };
+    }
+
+    /**
+     * Acquire, transition the image for presentation, and present it; the device is idle afterwards so the
+     * semaphores and the command buffer can be reused right away.
+     */
+    bool frame(vk::Swapchain& swapchain, std::uint64_t completion = 0)
+    {
+        auto image = swapchain.acquire(acquired);
+        if (not image) {
+            return false;
+        }
+
+        fn.reset_command_pool(device, pool, 0);
+
+        auto begin = VkCommandBufferBeginInfo{
+            .sType            = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+            .pNext            = nullptr,
+            .flags            = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT,
+            .pInheritanceInfo = nullptr,
+        };
+        fn.begin_command_buffer(commands, &begin);
+
+        auto barrier = VkImageMemoryBarrier{
+            .sType               = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+            .pNext               = nullptr,
+            .srcAccessMask       = 0,
+            .dstAccessMask       = 0,
+            .oldLayout           = VK_IMAGE_LAYOUT_UNDEFINED,
+            .newLayout           = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR,
+            .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+            .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+            .image               = image->image,
+            .subresourceRange    = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 },
+        };
+        fn.pipeline_barrier(
+            commands,
+            VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+            VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+            0,
+            0,
+            nullptr,
+            0,
+            nullptr,
+            1,
+            &barrier
+        );
+        fn.end_command_buffer(commands);
+
+        auto wait_stage = VkPipelineStageFlags{ VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT };
+        auto submit     = VkSubmitInfo{
+            .sType                = VK_STRUCTURE_TYPE_SUBMIT_INFO,
+            .pNext                = nullptr,
+            .waitSemaphoreCount   = 1,
+            .pWaitSemaphores      = &acquired,
+            .pWaitDstStageMask    = &wait_stage,
+            .commandBufferCount   = 1,
+            .pCommandBuffers      = &commands,
+            .signalSemaphoreCount = 1,
+            .pSignalSemaphores    = &rendered,
+        };
+        if (fn.queue_submit(queue, 1, &submit, VK_NULL_HANDLE) != VK_SUCCESS) {
+            return false;
+        }
+
+        swapchain.present(queue, image->index, rendered, completion);
+        fn.queue_wait_idle(queue);
+
+        return true;
+    }
+
+    std::uint64_t counter() const
+    {
+        auto value = std::uint64_t{};
+        fn.get_counter_value(device, timeline, &value);
+        return value;
+    }
+
+    // the timeline is signaled by the host, so the test decides when a frame counts as complete
+    void complete(std::uint64_t value) const
+    {
+        auto info = VkSemaphoreSignalInfo{
+            .sType     = VK_STRUCTURE_TYPE_SEMAPHORE_SIGNAL_INFO,
+            .pNext     = nullptr,
+            .semaphore = timeline,
+            .value     = value,
+        };
+        fn.signal_semaphore(device, &info);
+    }
+};
+
+template <typename Fn>
+bool load(Fn& fn, vk::Proc proc)
+{
+    fn = reinterpret_cast<Fn>(proc);
+    return fn != nullptr;
+}
+
+bool create_instance(Context& context)
+{
+    auto create = PFN_vkCreateInstance{};
+    if (not load(create, vk::get_instance_proc_address_noexcept(VK_NULL_HANDLE, "vkCreateInstance"))) {
+        return false;
+    }
+
+    auto extensions = vk::get_required_instance_extensions();
+    auto app        = VkApplicationInfo{
+        .sType              = VK_STRUCTURE_TYPE_APPLICATION_INFO,
+        .pNext              = nullptr,
+        .pApplicationName   = "vulkan_swapchain_test",
+        .applicationVersion = 0,
+        .pEngineName        = nullptr,
+        .engineVersion      = 0,
+        .apiVersion         = VK_API_VERSION_1_2,
+    };
+    auto info = VkInstanceCreateInfo{
+        .sType                   = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO,
+        .pNext                   = nullptr,
+        .flags                   = 0,
+        .pApplicationInfo        = &app,
+        .enabledLayerCount       = 0,
+        .ppEnabledLayerNames     = nullptr,
+        .enabledExtensionCount   = static_cast<std::uint32_t>(extensions.size()),
+        .ppEnabledExtensionNames = extensions.data(),
+    };
+    if (create(&info, nullptr, &context.instance) != VK_SUCCESS) {
+        return false;
+    }
+
+    auto instance = [&]<typename Fn>(Fn& out, const char* name) {
+        return load(out, vk::get_instance_proc_address_noexcept(context.instance, name));
+    };
+
+    auto& fn = context.fn;
+    return instance(fn.destroy_instance, "vkDestroyInstance")
+       and instance(fn.enumerate_devices, "vkEnumeratePhysicalDevices")
+       and instance(fn.get_properties, "vkGetPhysicalDeviceProperties")
+       and instance(fn.get_features, "vkGetPhysicalDeviceFeatures2")
+       and instance(fn.get_queue_families, "vkGetPhysicalDeviceQueueFamilyProperties")
+       and instance(fn.get_surface_support, "vkGetPhysicalDeviceSurfaceSupportKHR")
+       and instance(fn.enumerate_extensions, "vkEnumerateDeviceExtensionProperties")
+       and instance(fn.create_device, "vkCreateDevice")
+       and instance(fn.get_device_proc, "vkGetDeviceProcAddr")
+       and instance(fn.destroy_surface, "vkDestroySurfaceKHR");
+}
+
+// a Vulkan 1.2 device with timeline semaphores, the swapchain extension, and a presenting graphics queue
+bool pick_device(Context& context)
+{
+    auto& fn = context.fn;
+
+    auto count = std::uint32_t{};
+    fn.enumerate_devices(context.instance, &count, nullptr);
+    auto devices = std::vector<VkPhysicalDevice>(count);
+    fn.enumerate_devices(context.instance, &count, devices.data());
+
+    for (auto device : devices) {
+        auto properties = VkPhysicalDeviceProperties{};
+        fn.get_properties(device, &properties);
+        if (properties.apiVersion < VK_API_VERSION_1_2) {
+            continue;
+        }
+
+        auto features12 = VkPhysicalDeviceVulkan12Features{};
+        features12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+        auto features    = VkPhysicalDeviceFeatures2{};
+        features.sType   = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+        features.pNext   = &features12;
+        fn.get_features(device, &features);
+        if (not features12.timelineSemaphore) {
+            continue;
+        }
+
+        auto ext_count = std::uint32_t{};
+        fn.enumerate_extensions(device, nullptr, &ext_count, nullptr);
+        auto extensions = std::vector<VkExtensionProperties>(ext_count);
+        fn.enumerate_extensions(device, nullptr, &ext_count, extensions.data());
+        auto has_swapchain = std::ranges::any_of(extensions, [](const VkExtensionProperties& ext) {
+            return std::strcmp(ext.extensionName, VK_KHR_SWAPCHAIN_EXTENSION_NAME) == 0;
+        });
+        if (not has_swapchain) {
+            continue;
+        }
+
+        auto family_count = std::uint32_t{};
+        fn.get_queue_families(device, &family_count, nullptr);
+        auto families = std::vector<VkQueueFamilyProperties>(family_count);
+        fn.get_queue_families(device, &family_count, families.data());
+
+        for (auto i = std::uint32_t{ 0 }; i < family_count; ++i) {
+            auto present = VkBool32{};
+            fn.get_surface_support(device, i, context.surface, &present);
+            if (present and (families[i].queueFlags & VK_QUEUE_GRAPHICS_BIT) != 0) {
+                context.physical_device = device;
+                context.family          = i;
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+bool create_device(Context& context)
+{
+    auto& fn = context.fn;
+
+    auto priority   = 1.0f;
+    auto queue_info = VkDeviceQueueCreateInfo{
+        .sType            = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO,
+        .pNext            = nullptr,
+        .flags            = 0,
+        .queueFamilyIndex = context.family,
+        .queueCount       = 1,
+        .pQueuePriorities = &priority,
+    };
+
+    auto features12              = VkPhysicalDeviceVulkan12Features{};
+    features12.sType             = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+    features12.timelineSemaphore = VK_TRUE;
+
+    const char* extension = VK_KHR_SWAPCHAIN_EXTENSION_NAME;
+    auto        info      = VkDeviceCreateInfo{
+        .sType                   = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO,
+        .pNext                   = &features12,
+        .flags                   = 0,
+        .queueCreateInfoCount    = 1,
+        .pQueueCreateInfos       = &queue_info,
+        .enabledLayerCount       = 0,
+        .ppEnabledLayerNames     = nullptr,
+        .enabledExtensionCount   = 1,
+        .ppEnabledExtensionNames = &extension,
+        .pEnabledFeatures        = nullptr,
+    };
+    if (fn.create_device(context.physical_device, &info, nullptr, &context.device) != VK_SUCCESS) {
+        return false;
+    }
+
+    auto device = [&]<typename Fn>(Fn& out, const char* name) {
+        return load(out, context.fn.get_device_proc(context.device, name));
+    };
+
+    return device(fn.destroy_device, "vkDestroyDevice")
+       and device(fn.get_queue, "vkGetDeviceQueue")
+       and device(fn.create_semaphore, "vkCreateSemaphore")
+       and device(fn.destroy_semaphore, "vkDestroySemaphore")
+       and device(fn.signal_semaphore, "vkSignalSemaphore")
+       and device(fn.get_counter_value, "vkGetSemaphoreCounterValue")
+       and device(fn.create_command_pool, "vkCreateCommandPool")
+       and device(fn.destroy_command_pool, "vkDestroyCommandPool")
+       and device(fn.reset_command_pool, "vkResetCommandPool")
+       and device(fn.allocate_command_buffer, "vkAllocateCommandBuffers")
+       and device(fn.begin_command_buffer, "vkBeginCommandBuffer")
+       and device(fn.end_command_buffer, "vkEndCommandBuffer")
+       and device(fn.pipeline_barrier, "vkCmdPipelineBarrier")
+       and device(fn.queue_submit, "vkQueueSubmit")
+       and device(fn.queue_wait_idle, "vkQueueWaitIdle");
+}
+
+bool create_objects(Context& context)
+{
+    auto& fn = context.fn;
+    fn.get_queue(context.device, context.family, 0, &context.queue);
+
+    auto binary = VkSemaphoreCreateInfo{
+        .sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO,
+        .pNext = nullptr,
+        .flags = 0,
+    };
+    auto timeline_type = VkSemaphoreTypeCreateInfo{
+        .sType         = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO,
+        .pNext         = nullptr,
+        .semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE,
+        .initialValue  = 0,
+    };
+    auto timeline  = binary;
+    timeline.pNext = &timeline_type;
+
+    auto pool_info = VkCommandPoolCreateInfo{
+        .sType            = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO,
+        .pNext            = nullptr,
+        .flags            = 0,
+        .queueFamilyIndex = context.family,
+    };
+
+    if (fn.create_semaphore(context.device, &binary, nullptr, &context.acquired) != VK_SUCCESS
+        or fn.create_semaphore(context.device, &binary, nullptr, &context.rendered) != VK_SUCCESS
+        or fn.create_semaphore(context.device, &timeline, nullptr, &context.timeline) != VK_SUCCESS
+        or fn.create_command_pool(context.device, &pool_info, nullptr, &context.pool) != VK_SUCCESS) {
+        return false;
+    }
+
+    auto alloc_info = VkCommandBufferAllocateInfo{
+        .sType              = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
+        .pNext              = nullptr,
+        .commandPool        = context.pool,
+        .level              = VK_COMMAND_BUFFER_LEVEL_PRIMARY,
+        .commandBufferCount = 1,
+    };
+    return fn.allocate_command_buffer(context.device, &alloc_info, &context.commands) == VK_SUCCESS;
+}
+
+/**
+ * Create everything the tests need, or nothing if there is no Vulkan loader, no ICD, or no device that fits.
+ */
+std::unique_ptr<Context> create_context(const glfw_cpp::Window& window)
+{
+    if (not vk::vulkan_supported()) {
+        return nullptr;
+    }
+
+    auto context = std::make_unique<Context>();
+    if (not create_instance(*context)) {
+        return nullptr;
+    }
+    if (vk::create_surface(window, context->instance, nullptr, &context->surface) != VK_SUCCESS) {
+        return nullptr;
+    }
+    if (not pick_device(*context) or not create_device(*context) or not create_objects(*context)) {
+        return nullptr;
+    }
+
+    return context;
+}
+
+int main()
+{
+    using ut::expect, ut::that;
+    using namespace ut::literals;
+    using namespace ut::operators;
+
+    // the null platform creates its surfaces with VK_EXT_headless_surface
+    auto glfw = glfw_cpp::init({ .platform = glfw_cpp::hint::Platform::Null });
+    glfw->apply_hints({ .api = glfw_cpp::api::NoApi{} });
+
+    auto window  = glfw->create_window(64, 48, "vulkan_swapchain_test");
+    auto context = create_context(window);
+    if (context == nullptr) {
+        std::puts("vulkan_swapchain_test: no Vulkan 1.2 device with a headless surface, skipped");
+        return 0;
+    }
+
+    "a replaced swapchain should live until the timeline passed its last frame"_test = [&] {
+        auto swapchain = vk::Swapchain{ window, context->config(3, true) };
+        expect(that % swapchain.generation() == 1u);
+
+        expect(context->frame(swapchain, 1));
+        expect(context->frame(swapchain, 2));
+
+        // the replacement happens in the next acquire, the old swapchain was last used by frame 2
+        swapchain.request_recreate();
+        expect(context->frame(swapchain, 3));
+        expect(that % swapchain.generation() == 2u);
+        expect(that % swapchain.retired_count() == 1u);
+
+        // the device is idle but the timeline says frame 2 is not complete, so the swapchain is kept
+        expect(context->frame(swapchain, 4));
+        expect(that % context->counter() == 0u);
+        expect(that % swapchain.retired_count() == 1u);
+
+        context->complete(2);
+        expect(context->frame(swapchain, 5));
+        expect(that % swapchain.retired_count() == 0u);
+    };
+
+    "without a timeline, replaced swapchains should share one idle wait"_test = [&] {
+        auto swapchain = vk::Swapchain{ window, context->config(2) };
+
+        // the resize is seen through the window events, the headless surface follows the framebuffer size
+        window.set_window_size(80, 60);
+        glfw->poll_events();
+        swapchain.process_events(window.swap_events());
+
+        expect(context->frame(swapchain));
+        expect(that % swapchain.generation() == 2u);
+        expect(that % swapchain.extent().width == 80u);
+        expect(that % swapchain.extent().height == 60u);
+        expect(that % swapchain.retired_count() == 1u);
+
+        swapchain.request_recreate();
+        expect(context->frame(swapchain));
+        expect(that % swapchain.generation() == 3u);
+
+        // the first replacement is due after two presents, the second one goes with it
+        expect(that % swapchain.retired_count() == 0u);
+    };
+}
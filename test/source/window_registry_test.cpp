@@ -0,0 +1,137 @@
+#include <boost/ut.hpp>
+
+#include <glfw_cpp/window_registry.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace ut = boost::ut;
+
+using glfw_cpp::WindowId;
+using glfw_cpp::WindowRegistry;
+
+// the registry never dereferences the handles, fake ones are enough
+GLFWwindow* fake_handle(std::uintptr_t value)
+{
+    return reinterpret_cast<GLFWwindow*>(value * 16);
+}
+
+int main()
+{
+    using ut::expect, ut::that;
+    using namespace ut::literals;
+    using namespace ut::operators;
+
+    [[maybe_unused]] ut::suite window_registry_tests = [] {
+        "inserted windows should be open and found by id"_test = [] {
+            auto registry = WindowRegistry{};
+
+            auto first  = registry.insert(fake_handle(1));
+            auto second = registry.insert(fake_handle(2));
+
+            expect(that % registry.size() == 2ul);
+            expect(that % registry.open_count() == 2ul);
+            expect(registry.get(first) == fake_handle(1));
+            expect(registry.get(second) == fake_handle(2));
+            expect(registry.get(WindowId{}) == nullptr);
+        };
+
+        "a window should be counted as closed once"_test = [] {
+            auto registry = WindowRegistry{};
+            auto id       = registry.insert(fake_handle(1));
+
+            expect(that % registry.mark_closed(id));
+            expect(that % not registry.mark_closed(id));
+            expect(that % registry.open_count() == 0ul);
+
+            // erasing a closed window does not count it twice
+            expect(registry.erase(id) == fake_handle(1));
+            expect(that % registry.open_count() == 0ul);
+            expect(that % registry.size() == 0ul);
+        };
+
+        "a window marked open again should count as open once"_test = [] {
+            auto registry = WindowRegistry{};
+            auto id       = registry.insert(fake_handle(1));
+
+            expect(that % not registry.mark_open(id));
+            registry.mark_closed(id);
+            expect(that % registry.mark_open(id));
+            expect(that % not registry.mark_open(id));
+            expect(that % registry.open_count() == 1ul);
+
+            // the reopened window is counted out once on erase
+            expect(registry.erase(id) == fake_handle(1));
+            expect(that % registry.open_count() == 0ul);
+            expect(that % not registry.mark_open(id));
+        };
+
+        "erasing an open window should update the open count"_test = [] {
+            auto registry = WindowRegistry{};
+            auto id       = registry.insert(fake_handle(1));
+            registry.insert(fake_handle(2));
+
+            expect(registry.erase(id) == fake_handle(1));
+            expect(registry.erase(id) == nullptr);
+            expect(that % registry.open_count() == 1ul);
+            expect(that % registry.size() == 1ul);
+        };
+
+        "a reused slot should not be reachable with a stale id"_test = [] {
+            auto registry = WindowRegistry{};
+
+            auto stale = registry.insert(fake_handle(1));
+            registry.erase(stale);
+            auto fresh = registry.insert(fake_handle(2));
+
+            expect(that % fresh.index == stale.index);
+            expect(that % fresh.generation != stale.generation);
+            expect(registry.get(stale) == nullptr);
+            expect(registry.get(fresh) == fake_handle(2));
+            expect(that % not registry.mark_closed(stale));
+            expect(that % registry.open_count() == 1ul);
+        };
+
+        "for_each should visit every registered window"_test = [] {
+            auto registry = WindowRegistry{};
+
+            auto ids = std::vector<WindowId>{};
+            for (std::uintptr_t i = 1; i <= 200; ++i) {
+                ids.push_back(registry.insert(fake_handle(i)));
+            }
+            for (std::size_t i = 0; i < ids.size(); i += 2) {
+                registry.erase(ids[i]);
+            }
+
+            auto count = 0ul;
+            registry.for_each([&](GLFWwindow*) { ++count; });
+            expect(that % count == 100ul);
+            expect(that % registry.open_count() == 100ul);
+        };
+
+        "windows closed from other threads should be counted once"_test = [] {
+            auto registry = WindowRegistry{};
+
+            auto ids = std::vector<WindowId>{};
+            for (std::uintptr_t i = 1; i <= 200; ++i) {
+                ids.push_back(registry.insert(fake_handle(i)));
+            }
+
+            // every window is closed by two threads at once
+            auto close_all = [&] {
+                for (auto id : ids) {
+                    registry.mark_closed(id);
+                }
+            };
+            auto first  = std::thread{ close_all };
+            auto second = std::thread{ close_all };
+            first.join();
+            second.join();
+
+            expect(that % registry.open_count() == 0ul);
+            expect(that % registry.size() == 200ul);
+        };
+    };
+}